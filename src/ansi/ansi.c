@@ -0,0 +1,282 @@
+#define _POSIX_C_SOURCE 200809L
+#include "ansi.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+#define MAX_SALTO_REESCRITA 4       // Até aqui, reescrever células iguais sai mais barato que mover o cursor
+
+// Um caractere UTF-8 (largura 1) e seu atributo
+typedef struct {
+    char texto[4];
+    unsigned char tamanho;
+    unsigned char atributo;
+} Celula;
+
+static Celula *frente = NULL;       // O que o terminal mostra
+static Celula *verso = NULL;        // O quadro sendo desenhado
+static int linhas = 0;
+static int colunas = 0;
+static int frente_valida = 0;
+
+static char *saida = NULL;
+static size_t capacidade_saida = 0;
+static size_t pos_saida = 0;
+
+// Estado do terminal depois do último quadro enviado
+static int linha_cursor = 0;
+static int coluna_cursor = 0;
+static int atributo_atual = 0;
+
+// Posição e atributo de desenho no verso
+static int linha_desenho = 0;
+static int coluna_desenho = 0;
+static int atributo_desenho = 0;
+
+static const Celula celula_vazia = { { ' ', 0, 0, 0 }, 1, 0 };
+
+// Pares de cores da ui (init_pair em inicializar_ncurses): frente/fundo ANSI
+static const char *sgr_pares[8] = {
+    "", ";36;40", ";32;40", ";33;40", ";31;40", ";34;40", ";37;40", ";30;47"
+};
+
+int ansi_iniciar(int novas_linhas, int novas_colunas) {
+    if (novas_linhas < 1) novas_linhas = 1;
+    if (novas_colunas < 1) novas_colunas = 1;
+    if (frente && novas_linhas == linhas && novas_colunas == colunas) {
+        return 1;
+    }
+
+    size_t celulas = (size_t)novas_linhas * (size_t)novas_colunas;
+    Celula *nova_frente = realloc(frente, celulas * sizeof(Celula));
+    if (!nova_frente) {
+        return 0;
+    }
+    frente = nova_frente;
+    Celula *novo_verso = realloc(verso, celulas * sizeof(Celula));
+    if (!novo_verso) {
+        return 0;
+    }
+    verso = novo_verso;
+
+    // Pior caso: cada célula com movimento de cursor, atributo e 4 bytes de texto
+    size_t nova_capacidade = celulas * 32 + 64;
+    char *nova_saida = realloc(saida, nova_capacidade);
+    if (!nova_saida) {
+        return 0;
+    }
+    saida = nova_saida;
+    capacidade_saida = nova_capacidade;
+
+    linhas = novas_linhas;
+    colunas = novas_colunas;
+    ansi_limpar();
+    ansi_invalidar();
+    return 1;
+}
+
+void ansi_finalizar(void) {
+    free(frente);
+    free(verso);
+    free(saida);
+    frente = verso = NULL;
+    saida = NULL;
+    capacidade_saida = 0;
+    linhas = colunas = 0;
+    frente_valida = 0;
+}
+
+void ansi_invalidar(void) {
+    frente_valida = 0;
+}
+
+void ansi_limpar(void) {
+    for (int i = 0; i < linhas * colunas; i++) {
+        verso[i] = celula_vazia;
+    }
+    linha_desenho = 0;
+    coluna_desenho = 0;
+    atributo_desenho = 0;
+}
+
+void ansi_mover(int linha, int coluna) {
+    linha_desenho = linha;
+    coluna_desenho = coluna;
+}
+
+void ansi_atributo(int atributo) {
+    atributo_desenho = atributo;
+}
+
+void ansi_escrever(const char *texto) {
+    ansi_escrever_n(texto, strlen(texto));
+}
+
+void ansi_escrever_n(const char *texto, size_t tamanho_texto) {
+    const unsigned char *p = (const unsigned char*)texto;
+    const unsigned char *fim = p + tamanho_texto;
+    while (p < fim && *p) {
+        int tamanho = 1;
+        if (*p >= 0xF0) tamanho = 4;
+        else if (*p >= 0xE0) tamanho = 3;
+        else if (*p >= 0xC0) tamanho = 2;
+        if (tamanho > fim - p) {
+            return;
+        }
+        for (int k = 1; k < tamanho; k++) {
+            if (p[k] == '\0') {
+                return;
+            }
+        }
+
+        if (linha_desenho >= 0 && linha_desenho < linhas &&
+            coluna_desenho >= 0 && coluna_desenho < colunas) {
+            Celula *c = &verso[linha_desenho * colunas + coluna_desenho];
+            memcpy(c->texto, p, (size_t)tamanho);
+            c->tamanho = (unsigned char)tamanho;
+            c->atributo = (unsigned char)atributo_desenho;
+        }
+        coluna_desenho++;
+        p += tamanho;
+    }
+}
+
+static int celulas_iguais(const Celula *a, const Celula *b) {
+    return a->tamanho == b->tamanho && a->atributo == b->atributo &&
+           memcmp(a->texto, b->texto, a->tamanho) == 0;
+}
+
+static int celula_em_branco(const Celula *c) {
+    return c->tamanho == 1 && c->texto[0] == ' ' && c->atributo == 0;
+}
+
+static void emitir(const char *bytes, size_t n) {
+    if (pos_saida + n <= capacidade_saida) {
+        memcpy(saida + pos_saida, bytes, n);
+        pos_saida += n;
+    }
+}
+
+static void emitir_formatado(const char *formato, int a, int b) {
+    char tmp[32];
+    int n = snprintf(tmp, sizeof(tmp), formato, a, b);
+    if (n > 0) {
+        emitir(tmp, (size_t)n);
+    }
+}
+
+static void emitir_cursor(int linha, int coluna) {
+    if (linha == linha_cursor && coluna == coluna_cursor) {
+        return;
+    }
+    if (linha == linha_cursor && coluna > coluna_cursor) {
+        emitir_formatado("\x1b[%dC", coluna - coluna_cursor, 0);
+    } else {
+        emitir_formatado("\x1b[%d;%dH", linha + 1, coluna + 1);
+    }
+    linha_cursor = linha;
+    coluna_cursor = coluna;
+}
+
+static void emitir_atributo(int atributo) {
+    if (atributo == atributo_atual) {
+        return;
+    }
+    emitir("\x1b[0", 3);
+    if (atributo & ANSI_NEGRITO) {
+        emitir(";1", 2);
+    }
+    const char *par = sgr_pares[atributo & 7];
+    emitir(par, strlen(par));
+    emitir("m", 1);
+    atributo_atual = atributo;
+}
+
+// Última coluna (exclusiva) com algo diferente de espaço sem atributo
+static int comprimento_linha(const Celula *linha) {
+    int n = colunas;
+    while (n > 0 && celula_em_branco(&linha[n - 1])) {
+        n--;
+    }
+    return n;
+}
+
+size_t ansi_apresentar(int fd, int *chamadas_write) {
+    *chamadas_write = 0;
+    if (!frente) {
+        return 0;
+    }
+    pos_saida = 0;
+
+    if (!frente_valida) {
+        // Estado do terminal desconhecido: limpa e trata a frente como vazia
+        static const char limpar_tela[] = "\x1b[0m\x1b[H\x1b[2J";
+        emitir(limpar_tela, sizeof(limpar_tela) - 1);
+        atributo_atual = 0;
+        linha_cursor = 0;
+        coluna_cursor = 0;
+        for (int i = 0; i < linhas * colunas; i++) {
+            frente[i] = celula_vazia;
+        }
+        frente_valida = 1;
+    }
+
+    for (int l = 0; l < linhas; l++) {
+        const Celula *v = &verso[l * colunas];
+        const Celula *f = &frente[l * colunas];
+        int fim_verso = comprimento_linha(v);
+
+        int c = 0;
+        while (c < fim_verso) {
+            if (celulas_iguais(&v[c], &f[c])) {
+                c++;
+                continue;
+            }
+            // Junta trechos alterados separados por poucas células iguais
+            int fim = c + 1;
+            for (int j = c + 1; j < fim_verso && j - fim < MAX_SALTO_REESCRITA; j++) {
+                if (!celulas_iguais(&v[j], &f[j])) {
+                    fim = j + 1;
+                }
+            }
+            emitir_cursor(l, c);
+            for (int k = c; k < fim; k++) {
+                emitir_atributo(v[k].atributo);
+                emitir(v[k].texto, v[k].tamanho);
+            }
+            // Na última coluna o terminal fica com a quebra pendente: próximo movimento é absoluto
+            coluna_cursor = fim;
+            if (fim >= colunas) {
+                linha_cursor = -1;
+            }
+            c = fim;
+        }
+
+        // Resto da linha ficou em branco: apaga até o fim de uma vez
+        if (comprimento_linha(f) > fim_verso) {
+            emitir_cursor(l, fim_verso);
+            emitir_atributo(0);
+            emitir("\x1b[K", 3);
+        }
+    }
+    emitir_atributo(0);
+    memcpy(frente, verso, (size_t)linhas * (size_t)colunas * sizeof(Celula));
+
+    size_t enviado = 0;
+    while (enviado < pos_saida) {
+        ssize_t n = write(fd, saida + enviado, pos_saida - enviado);
+        (*chamadas_write)++;
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // Terminal perdeu parte do quadro: o próximo sai completo
+            frente_valida = 0;
+            break;
+        }
+        enviado += (size_t)n;
+    }
+    return enviado;
+}
@@ -0,0 +1,31 @@
+#ifndef ANSI_H
+#define ANSI_H
+
+#include <stddef.h>
+
+// Renderizador alternativo da tela da partida (TEDAX_RENDERIZADOR=ansi): a tela é
+// desenhada num buffer de células (verso) e comparada com o que o terminal já mostra
+// (frente). Só as células que mudaram viram sequências de escape — movimento de
+// cursor, atributos e texto — e o quadro inteiro sai num único write().
+
+#define ANSI_NEGRITO 0x80           // Somado ao par de cores (0 = cor padrão, 1..7 = pares da ui)
+
+// (Re)dimensiona os buffers; mudança de tamanho força um quadro completo. Retorna 0 sem memória
+int ansi_iniciar(int linhas, int colunas);
+void ansi_finalizar(void);
+
+// O terminal foi desenhado por outro (ncurses): o próximo quadro limpa e redesenha tudo
+void ansi_invalidar(void);
+
+// Desenho no verso; texto fora da tela é cortado
+void ansi_limpar(void);
+void ansi_mover(int linha, int coluna);
+void ansi_atributo(int atributo);
+void ansi_escrever(const char *texto);
+void ansi_escrever_n(const char *texto, size_t tamanho);
+
+// Envia a diferença verso/frente para fd. Retorna os bytes escritos e quantas
+// chamadas write() foram feitas (normalmente 1; 0 se nada mudou)
+size_t ansi_apresentar(int fd, int *chamadas_write);
+
+#endif // ANSI_H
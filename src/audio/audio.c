@@ -1,150 +1,567 @@
+#define _POSIX_C_SOURCE 200809L
 #include "audio.h"
+#include "../comum/comum.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
 
 #ifdef HAVE_SDL2_MIXER
 #include <SDL2/SDL_mixer.h>
-static Mix_Music *musica_atual = NULL;
-static int audio_inicializado = 0;
-#else
-static int audio_inicializado = 0;
+static Mix_Music *musica_atual = NULL;     // Só a thread de áudio mexe
 #endif
 
-// Flags
-static int e_fase_media = 0;
-static int musica_ligada = 0;
+// Todo o trabalho do SDL_mixer (carregar, tocar, parar, volume) roda na thread de áudio.
+// Quem joga ou desenha só põe um comando na fila (sem trava, nunca bloqueia) e segue;
+// o fim de uma música chega pelo gancho do mixer, sem ninguém consultar em laço.
 
-int inicializar_audio(void) {
-#ifdef HAVE_SDL2_MIXER
-    // Inicializar SDL_mixer
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
-        fprintf(stderr, "Aviso: Não foi possível inicializar áudio: %s\n", Mix_GetError());
+typedef enum {
+    AUDIO_TOCAR,            // Música em loop
+    AUDIO_EFEITO,           // Uma vez, no lugar da música
+    AUDIO_EM_SEGUIDA,       // Em loop, quando o efeito atual acabar (ou já, sem efeito)
+    AUDIO_PARAR,
+    AUDIO_VOLUME
+} TipoComandoAudio;
+
+typedef struct {
+    TipoComandoAudio tipo;
+    int volume;
+    char arquivo[64];
+} ComandoAudio;
+
+// Fila limitada de vários produtores e um consumidor: cada célula tem um número de
+// sequência que diz de quem é a vez (produtor na posição p: sequencia == p; consumidor:
+// sequencia == p + 1). Produtores disputam só a posição de escrita, por CAS
+typedef struct {
+    atomic_size_t sequencia;
+    ComandoAudio comando;
+} CelulaAudio;
+
+static CelulaAudio fila_audio[CAPACIDADE_FILA_AUDIO];
+static atomic_size_t posicao_escrita;
+static sem_t sinal_audio;                   // Comando novo, música terminou ou encerrar
+static pthread_t thread_audio_id;
+static atomic_int encerrar_audio;
+static atomic_int tocando;                  // Publicado pela thread de áudio
+static atomic_long comandos_descartados;
+static int audio_inicializado = 0;
+
+// Estado de quem chama (menus, main): entra no comando na hora de enfileirar
+static atomic_int e_fase_media;
+static atomic_int musica_ligada;
+
+static int enfileirar(const ComandoAudio *comando) {
+    size_t pos = atomic_load_explicit(&posicao_escrita, memory_order_relaxed);
+    CelulaAudio *celula;
+    while (1) {
+        celula = &fila_audio[pos % CAPACIDADE_FILA_AUDIO];
+        size_t seq = atomic_load_explicit(&celula->sequencia, memory_order_acquire);
+        intptr_t diferenca = (intptr_t)seq - (intptr_t)pos;
+        if (diferenca == 0) {
+            if (atomic_compare_exchange_weak_explicit(&posicao_escrita, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diferenca < 0) {
+            // Cheia: a thread de áudio está atrasada; o comando se perde, quem chamou não espera
+            atomic_fetch_add_explicit(&comandos_descartados, 1, memory_order_relaxed);
+            return 0;
+        } else {
+            pos = atomic_load_explicit(&posicao_escrita, memory_order_relaxed);
+        }
+    }
+    celula->comando = *comando;
+    atomic_store_explicit(&celula->sequencia, pos + 1, memory_order_release);
+    sem_post(&sinal_audio);
+    return 1;
+}
+
+static int enviar(TipoComandoAudio tipo, int volume, const char *arquivo) {
+    if (!audio_inicializado) {
         return 0;
     }
-    
-    // Permitir MP3
-    int flags = MIX_INIT_MP3;
-    if ((Mix_Init(flags) & flags) != flags) {
-        fprintf(stderr, "Aviso: Suporte MP3 não disponível: %s\n", Mix_GetError());
+    ComandoAudio comando;
+    comando.tipo = tipo;
+    comando.volume = volume;
+    snprintf(comando.arquivo, sizeof(comando.arquivo), "%s", arquivo ? arquivo : "");
+    return enfileirar(&comando);
+}
+
+static size_t posicao_leitura;              // Só a thread de áudio
+static long comandos_executados;            // Só a thread de áudio; ler depois de finalizar_audio
+
+static int retirar(ComandoAudio *comando) {
+    CelulaAudio *celula = &fila_audio[posicao_leitura % CAPACIDADE_FILA_AUDIO];
+    size_t seq = atomic_load_explicit(&celula->sequencia, memory_order_acquire);
+    if (seq != posicao_leitura + 1) {
+        return 0;
     }
-    
-    audio_inicializado = 1;
+    *comando = celula->comando;
+    atomic_store_explicit(&celula->sequencia, posicao_leitura + CAPACIDADE_FILA_AUDIO, memory_order_release);
+    posicao_leitura++;
     return 1;
-#else
-    fprintf(stderr, "Aviso: SDL2_mixer não está disponível. Áudio desabilitado.\n");
-    fprintf(stderr, "Para habilitar áudio, instale: sudo apt-get install libsdl2-mixer-dev\n");
-    audio_inicializado = 0;
-    return 0;
-#endif
 }
 
-int audio_disponivel(void) { return audio_inicializado; }
-void definir_dificuldade_musica(int e_fase_media_flag) { e_fase_media = e_fase_media_flag; }
+static atomic_int musica_terminou;          // Gancho do mixer -> thread de áudio
 
-// Quando a música é desligada, o volume é definido como 0
-void definir_musica_ligada(int ligada) {
-    musica_ligada = ligada;
-    if (!ligada && audio_inicializado) {
-#ifdef HAVE_SDL2_MIXER
-        Mix_VolumeMusic(0);
-#endif
-    }
+// Chamado pelo mixer (na thread dele) quando a música acaba ou é parada; sem SDL aqui
+static void ao_terminar_musica(void) {
+    atomic_store(&musica_terminou, 1);
+    sem_post(&sinal_audio);
 }
 
-int tocar_musica(const char* arquivo) {
+// Primitivas da saída: SDL_mixer ou, sem ele, a saída nula que não decodifica nada
 #ifdef HAVE_SDL2_MIXER
+static int musica_parada(void) {
+    return !Mix_PlayingMusic();
+}
+
+static void ajustar_volume(int volume) {
+    Mix_VolumeMusic(volume);
+}
+
+static void liberar_musica_atual(void) {
+    Mix_HaltMusic();
     if (musica_atual) {
-        Mix_HaltMusic();
         Mix_FreeMusic(musica_atual);
         musica_atual = NULL;
     }
-    
+}
+
+static int tocar_agora(const char *arquivo, int volume, int loops) {
+    liberar_musica_atual();
+
     musica_atual = Mix_LoadMUS(arquivo);
     if (!musica_atual) {
         fprintf(stderr, "Aviso: Não foi possível carregar música %s: %s\n", arquivo, Mix_GetError());
         return 0;
     }
-    
-    int volume = 0; // Volume quando inicializa: 0
-    if (musica_ligada) {
-        volume = 64; // Volume padrão
-        if (e_fase_media) {
-            volume = 80; // Um pouco mais alto
-        }
-    }
     Mix_VolumeMusic(volume);
-    
-    // Tocar músicas em loop (-1 = loop infinito)
-    if (Mix_PlayMusic(musica_atual, -1) < 0) {
+
+    // loops: -1 = loop infinito, 0 = uma vez
+    if (Mix_PlayMusic(musica_atual, loops) < 0) {
         fprintf(stderr, "Aviso: Não foi possível tocar música: %s\n", Mix_GetError());
         Mix_FreeMusic(musica_atual);
         musica_atual = NULL;
         return 0;
     }
-    
     return 1;
+}
 #else
+// Sem decodificar não se sabe a duração: o efeito (loops = 0) termina assim que começa,
+// o que ainda passa pelo gancho de fim e pelo encadeamento de AUDIO_EM_SEGUIDA
+static int musica_simulada = 0;
+
+static int musica_parada(void) {
+    return !musica_simulada;
+}
+
+static void ajustar_volume(int volume) {
+    (void)volume;
+}
+
+static void liberar_musica_atual(void) {
+    musica_simulada = 0;
+}
+
+static int tocar_agora(const char *arquivo, int volume, int loops) {
     (void)arquivo;
-    return 0;
+    (void)volume;
+    musica_simulada = loops != 0;
+    if (!musica_simulada) {
+        ao_terminar_musica();
+    }
+    return 1;
+}
 #endif
+
+static void* thread_audio(void *arg) {
+    (void)arg;
+    ComandoAudio proxima;               // AUDIO_EM_SEGUIDA à espera do fim do efeito
+    int tem_proxima = 0;
+    int efeito_tocando = 0;
+
+    while (!atomic_load(&encerrar_audio)) {
+        while (sem_wait(&sinal_audio) != 0 && errno == EINTR) {
+        }
+
+        // O gancho também dispara quando a própria thread troca ou para a música: só vale se parou mesmo
+        if (atomic_exchange(&musica_terminou, 0) && musica_parada()) {
+            atomic_store(&tocando, 0);
+            if (efeito_tocando && tem_proxima) {
+                atomic_store(&tocando, tocar_agora(proxima.arquivo, proxima.volume, -1));
+                tem_proxima = 0;
+            }
+            efeito_tocando = 0;
+        }
+
+        ComandoAudio comando;
+        while (retirar(&comando)) {
+            comandos_executados++;
+            if (comando.tipo == AUDIO_EM_SEGUIDA && efeito_tocando && atomic_load(&tocando)) {
+                proxima = comando;
+                tem_proxima = 1;
+                continue;
+            }
+            if (comando.tipo != AUDIO_VOLUME) {
+                tem_proxima = 0;
+                efeito_tocando = comando.tipo == AUDIO_EFEITO;
+            }
+            switch (comando.tipo) {
+                case AUDIO_TOCAR:
+                case AUDIO_EM_SEGUIDA:
+                    atomic_store(&tocando, tocar_agora(comando.arquivo, comando.volume, -1));
+                    break;
+                case AUDIO_EFEITO:
+                    atomic_store(&tocando, tocar_agora(comando.arquivo, comando.volume, 0));
+                    break;
+                case AUDIO_PARAR:
+                    liberar_musica_atual();
+                    atomic_store(&tocando, 0);
+                    break;
+                case AUDIO_VOLUME:
+                    ajustar_volume(comando.volume);
+                    break;
+            }
+        }
+    }
+
+    liberar_musica_atual();
+    atomic_store(&tocando, 0);
+    return NULL;
+}
+
+// Saída do mixer: TEDAX_AUDIO=nulo ou wav[:arquivo] troca o dispositivo pelo driver "dummy"
+// do SDL (mesmo ritmo de tempo real, sem placa de som); com wav, o som mixado também é
+// gravado. Em qualquer saída, o callback de pós-mixagem mede cada buffer na thread de
+// mixagem do SDL: CPU gasta desde o buffer anterior (decodificar + mixar) e buffers
+// atrasados. Sem SDL2_mixer só existe a saída nula, que não decodifica nem mede buffers
+typedef enum {
+    SAIDA_SDL,
+    SAIDA_NULA,
+    SAIDA_WAV
+} SaidaAudio;
+
+static SaidaAudio saida_audio = SAIDA_SDL;
+
+// Lê TEDAX_AUDIO antes de abrir o dispositivo
+static const char* escolher_saida_audio(void) {
+    const char *escolha = getenv("TEDAX_AUDIO");
+    saida_audio = SAIDA_SDL;
+    if (!escolha || strcmp(escolha, "sdl") == 0) {
+        return NULL;
+    }
+    if (strcmp(escolha, "nulo") == 0) {
+        saida_audio = SAIDA_NULA;
+    } else if (strncmp(escolha, "wav", 3) == 0) {
+        saida_audio = SAIDA_WAV;
+        if (escolha[3] == ':' && escolha[4] != '\0') {
+            return escolha + 4;
+        }
+        return ARQUIVO_WAV_PADRAO;
+    } else {
+        fprintf(stderr, "Aviso: TEDAX_AUDIO=%s desconhecido (use sdl, nulo ou wav[:arquivo])\n", escolha);
+    }
+    return NULL;
 }
 
-int tocar_sound_effect(const char* arquivo) {
 #ifdef HAVE_SDL2_MIXER
-    // Se já tem música tocando, parar primeiro
-    if (musica_atual) {
-        Mix_HaltMusic();
-        Mix_FreeMusic(musica_atual);
-        musica_atual = NULL;
+static const char *nomes_saida[] = { "sdl", "nulo", "wav" };
+static FILE *arquivo_wav = NULL;
+
+// Escritas só pela thread de mixagem; lidas depois de Mix_CloseAudio
+static struct {
+    int frequencia;
+    int canais;
+    int bytes_por_quadro;
+    long buffers;
+    long atrasados;                 // Buffer que chegou mais de meio buffer depois do esperado
+    double cpu_total_ms;
+    double cpu_max_ms;
+    long long bytes_gravados;
+    struct timespec primeiro, ultimo, cpu_ultimo;
+} medicao_audio;
+
+static void escrever_u32_le(unsigned char *p, unsigned int v) {
+    p[0] = v & 0xff;
+    p[1] = (v >> 8) & 0xff;
+    p[2] = (v >> 16) & 0xff;
+    p[3] = (v >> 24) & 0xff;
+}
+
+// Cabeçalho RIFF de PCM 16 bits; os tamanhos são corrigidos em finalizar_audio
+static void escrever_cabecalho_wav(FILE *f, int frequencia, int canais, unsigned int bytes_dados) {
+    unsigned char c[44];
+    memcpy(c, "RIFF", 4);
+    escrever_u32_le(c + 4, 36 + bytes_dados);
+    memcpy(c + 8, "WAVEfmt ", 8);
+    escrever_u32_le(c + 16, 16);
+    c[20] = 1; c[21] = 0;                                   // PCM
+    c[22] = (unsigned char)canais; c[23] = 0;
+    escrever_u32_le(c + 24, (unsigned int)frequencia);
+    escrever_u32_le(c + 28, (unsigned int)(frequencia * canais * 2));
+    c[32] = (unsigned char)(canais * 2); c[33] = 0;
+    c[34] = 16; c[35] = 0;
+    memcpy(c + 36, "data", 4);
+    escrever_u32_le(c + 40, bytes_dados);
+    fseek(f, 0, SEEK_SET);
+    fwrite(c, 1, sizeof(c), f);
+}
+
+static void apos_mixagem(void *dados, Uint8 *stream, int len) {
+    (void)dados;
+    struct timespec agora, cpu;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu);
+
+    if (medicao_audio.buffers == 0) {
+        medicao_audio.primeiro = agora;
+    } else {
+        double gasto = ms_entre(&medicao_audio.cpu_ultimo, &cpu);
+        medicao_audio.cpu_total_ms += gasto;
+        if (gasto > medicao_audio.cpu_max_ms) {
+            medicao_audio.cpu_max_ms = gasto;
+        }
+        // Som contido no buffer: chegar mais de meio buffer depois do anterior é atraso
+        double duracao_ms = (double)len / medicao_audio.bytes_por_quadro * 1000.0 / medicao_audio.frequencia;
+        if (ms_entre(&medicao_audio.ultimo, &agora) > 1.5 * duracao_ms) {
+            medicao_audio.atrasados++;
+        }
     }
-    
-    musica_atual = Mix_LoadMUS(arquivo);
-    if (!musica_atual) {
-        fprintf(stderr, "Aviso: Não foi possível carregar música %s: %s\n", arquivo, Mix_GetError());
-        return 0;
+    medicao_audio.buffers++;
+    medicao_audio.ultimo = agora;
+    medicao_audio.cpu_ultimo = cpu;
+
+    if (arquivo_wav) {
+        medicao_audio.bytes_gravados += (long long)fwrite(stream, 1, (size_t)len, arquivo_wav);
     }
-    
-    int volume = 0; // Volume quando inicializa: 0
-    if (musica_ligada) { volume = 64; } // Volume padrão
-    Mix_VolumeMusic(volume);
-    
-    // Tocar sound effect uma vez (0 = sem loop)
-    if (Mix_PlayMusic(musica_atual, 0) < 0) {
-        fprintf(stderr, "Aviso: Não foi possível tocar música: %s\n", Mix_GetError());
-        Mix_FreeMusic(musica_atual);
-        musica_atual = NULL;
+}
+#endif
+
+// Fila e thread de áudio, comuns às saídas
+static void iniciar_thread_audio(void) {
+    for (size_t i = 0; i < CAPACIDADE_FILA_AUDIO; i++) {
+        atomic_init(&fila_audio[i].sequencia, i);
+    }
+    atomic_store(&posicao_escrita, 0);
+    posicao_leitura = 0;
+    comandos_executados = 0;
+    atomic_store(&encerrar_audio, 0);
+    atomic_store(&musica_terminou, 0);
+    atomic_store(&tocando, 0);
+    sem_init(&sinal_audio, 0, 0);
+    pthread_create(&thread_audio_id, NULL, thread_audio, NULL);
+}
+
+int inicializar_audio(void) {
+#ifdef HAVE_SDL2_MIXER
+    // Sem placa de som: o driver "dummy" consome os buffers no ritmo do relógio
+    const char *caminho_wav = escolher_saida_audio();
+    if (saida_audio != SAIDA_SDL) {
+        setenv("SDL_AUDIODRIVER", "dummy", 1);
+    }
+
+    // Inicializar SDL_mixer
+    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
+        fprintf(stderr, "Aviso: Não foi possível inicializar áudio: %s\n", Mix_GetError());
         return 0;
     }
-    
+
+    int frequencia = 44100;
+    int canais = 2;
+    Uint16 formato = MIX_DEFAULT_FORMAT;
+    Mix_QuerySpec(&frequencia, &formato, &canais);
+    memset(&medicao_audio, 0, sizeof(medicao_audio));
+    medicao_audio.bytes_por_quadro = canais * (SDL_AUDIO_BITSIZE(formato) / 8);
+    medicao_audio.frequencia = frequencia;
+    medicao_audio.canais = canais;
+    if (saida_audio == SAIDA_WAV) {
+        arquivo_wav = fopen(caminho_wav, "wb");
+        if (!arquivo_wav || SDL_AUDIO_BITSIZE(formato) != 16) {
+            fprintf(stderr, "Aviso: Não foi possível gravar %s (saída nula)\n", caminho_wav);
+            if (arquivo_wav) {
+                fclose(arquivo_wav);
+                arquivo_wav = NULL;
+            }
+            saida_audio = SAIDA_NULA;
+        } else {
+            escrever_cabecalho_wav(arquivo_wav, frequencia, canais, 0);
+        }
+    }
+    Mix_SetPostMix(apos_mixagem, NULL);
+
+    // Permitir MP3
+    int flags = MIX_INIT_MP3;
+    if ((Mix_Init(flags) & flags) != flags) {
+        fprintf(stderr, "Aviso: Suporte MP3 não disponível: %s\n", Mix_GetError());
+    }
+
+    Mix_HookMusicFinished(ao_terminar_musica);
+    iniciar_thread_audio();
+
+    audio_inicializado = 1;
     return 1;
 #else
-    (void)arquivo;
-    return 0;
+    // Só a saída nula: comandos passam pela fila e pela thread, sem decodificar
+    escolher_saida_audio();
+    if (saida_audio == SAIDA_WAV) {
+        fprintf(stderr, "Aviso: TEDAX_AUDIO=wav requer SDL2_mixer (usando a saida nula)\n");
+        saida_audio = SAIDA_NULA;
+    }
+    if (saida_audio != SAIDA_NULA) {
+        fprintf(stderr, "Aviso: SDL2_mixer não está disponível. Áudio desabilitado.\n");
+        fprintf(stderr, "Para habilitar áudio, instale: sudo apt-get install libsdl2-mixer-dev\n");
+        audio_inicializado = 0;
+        return 0;
+    }
+    iniciar_thread_audio();
+    audio_inicializado = 1;
+    return 1;
 #endif
 }
 
-void parar_musica(void) {
-#ifdef HAVE_SDL2_MIXER
-    Mix_HaltMusic();
-    if (musica_atual) {
-        Mix_FreeMusic(musica_atual);
-        musica_atual = NULL;
+int audio_disponivel(void) { return audio_inicializado; }
+void definir_dificuldade_musica(int e_fase_media_flag) { atomic_store(&e_fase_media, e_fase_media_flag); }
+
+// Quando a música é desligada, o volume é definido como 0
+void definir_musica_ligada(int ligada) {
+    atomic_store(&musica_ligada, ligada);
+    if (!ligada) {
+        enviar(AUDIO_VOLUME, 0, NULL);
     }
-#endif
+}
+
+// Volume quando inicializa: 0 com a música desligada; 64 padrão, 80 na fase média
+static int volume_musica(void) {
+    if (!atomic_load(&musica_ligada)) {
+        return 0;
+    }
+    return atomic_load(&e_fase_media) ? 80 : 64;
+}
+
+// Arquivo ausente é recusado aqui (o menu avisa); erro de decodificação só aparece na thread de áudio
+int tocar_musica(const char* arquivo) {
+    if (!audio_inicializado || access(arquivo, R_OK) != 0) {
+        return 0;
+    }
+    return enviar(AUDIO_TOCAR, volume_musica(), arquivo);
+}
+
+int tocar_sound_effect(const char* arquivo) {
+    if (!audio_inicializado || access(arquivo, R_OK) != 0) {
+        return 0;
+    }
+    return enviar(AUDIO_EFEITO, atomic_load(&musica_ligada) ? 64 : 0, arquivo);
+}
+
+int tocar_musica_em_seguida(const char* arquivo) {
+    if (!audio_inicializado || access(arquivo, R_OK) != 0) {
+        return 0;
+    }
+    return enviar(AUDIO_EM_SEGUIDA, volume_musica(), arquivo);
+}
+
+void parar_musica(void) {
+    enviar(AUDIO_PARAR, 0, NULL);
 }
 
 int musica_tocando(void) {
-#ifdef HAVE_SDL2_MIXER
-    return Mix_PlayingMusic() == 1;
-#else
-    return 0;
-#endif
+    return atomic_load(&tocando);
+}
+
+long comandos_audio_descartados(void) {
+    return atomic_load(&comandos_descartados);
 }
 
 void finalizar_audio(void) {
+    if (!audio_inicializado) {
+        return;
+    }
+    // Encerrar não passa pela fila: nunca se perde, mesmo com ela cheia
+    atomic_store(&encerrar_audio, 1);
+    sem_post(&sinal_audio);
+    pthread_join(thread_audio_id, NULL);
 #ifdef HAVE_SDL2_MIXER
-    parar_musica();
+    Mix_HookMusicFinished(NULL);
+    Mix_SetPostMix(NULL, NULL);
     Mix_CloseAudio();
     Mix_Quit();
+    if (arquivo_wav) {
+        escrever_cabecalho_wav(arquivo_wav, medicao_audio.frequencia, medicao_audio.canais, (unsigned int)medicao_audio.bytes_gravados);
+        fclose(arquivo_wav);
+        arquivo_wav = NULL;
+    }
+#endif
+    sem_destroy(&sinal_audio);
+    audio_inicializado = 0;
+}
+
+long comandos_audio_executados(void) {
+    return comandos_executados;
+}
+
+void estatisticas_audio(const char **saida, long *buffers, double *media_ms, double *max_ms,
+                        double *cpu_percentual, long *atrasados) {
+#ifdef HAVE_SDL2_MIXER
+    double duracao_ms = ms_entre(&medicao_audio.primeiro, &medicao_audio.ultimo);
+    *saida = nomes_saida[saida_audio];
+    *buffers = medicao_audio.buffers;
+    *media_ms = medicao_audio.buffers > 1 ? medicao_audio.cpu_total_ms / (medicao_audio.buffers - 1) : 0;
+    *max_ms = medicao_audio.cpu_max_ms;
+    *cpu_percentual = duracao_ms > 0 ? 100.0 * medicao_audio.cpu_total_ms / duracao_ms : 0;
+    *atrasados = medicao_audio.atrasados;
+#else
+    *saida = audio_inicializado || comandos_executados > 0 ? "nulo, sem decodificar" : "desligado";
+    *buffers = 0;
+    *media_ms = 0;
+    *max_ms = 0;
+    *cpu_percentual = 0;
+    *atrasados = 0;
 #endif
-}
\ No newline at end of file
+}
+
+int executar_bench_audio(int segundos, const char *musica) {
+    if (segundos < 1) {
+        segundos = 10;
+    }
+    if (!musica) {
+        musica = "sounds/Fase_1.mp3";
+    }
+    // Sem escolha explícita, o bench não precisa de placa de som
+    if (!getenv("TEDAX_AUDIO")) {
+        setenv("TEDAX_AUDIO", "nulo", 1);
+    }
+    if (!inicializar_audio()) {
+        return 1;
+    }
+    definir_musica_ligada(1);
+    if (!tocar_musica(musica)) {
+        fprintf(stderr, "Erro: nao foi possivel ler %s\n", musica);
+        finalizar_audio();
+        return 1;
+    }
+
+    // Metade do tempo na música; no meio, o efeito de vitória e a música de novo em seguida
+    struct timespec metade = { segundos / 2, (segundos % 2) * 500000000L };
+    nanosleep(&metade, NULL);
+    tocar_sound_effect("sounds/win.mp3");
+    tocar_musica_em_seguida(musica);
+    nanosleep(&metade, NULL);
+
+    finalizar_audio();
+    const char *saida;
+    long buffers, atrasados;
+    double media_ms, max_ms, cpu_percentual;
+    estatisticas_audio(&saida, &buffers, &media_ms, &max_ms, &cpu_percentual, &atrasados);
+    printf("Audio (%s): %ld buffers, decodificar+mixar %.3f ms por buffer (max %.3f), "
+           "%.2f%% de um nucleo, %ld buffer(s) atrasado(s), %ld comando(s) executado(s), "
+           "%ld descartado(s)\n", saida, buffers, media_ms, max_ms, cpu_percentual, atrasados,
+           comandos_audio_executados(), comandos_audio_descartados());
+    return 0;
+}
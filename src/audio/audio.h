@@ -1,14 +1,40 @@
 #ifndef AUDIO_H
 #define AUDIO_H
 
+// Áudio numa thread própria: as funções abaixo só enfileiram um comando (sem trava) e
+// retornam na hora, de qualquer thread. Retornam 0 sem áudio, com o arquivo ausente ou
+// com a fila cheia (o comando é descartado, nunca esperado).
+//
+// TEDAX_AUDIO escolhe a saída do mixer: sdl (padrão, placa de som), nulo (driver "dummy" do
+// SDL, no ritmo do relógio e sem som) ou wav[:arquivo] (nulo + o som mixado gravado em WAV).
+// As mesmas chamadas decodificam e mixam em todas; só muda para onde vai o som. Compilado
+// sem SDL2_mixer, só existe nulo: os comandos passam pela fila e pela thread de áudio, mas
+// nada é decodificado (um efeito termina assim que começa).
+#define CAPACIDADE_FILA_AUDIO 32
+#define ARQUIVO_WAV_PADRAO "audio.wav"
+
 int inicializar_audio(void);
 int audio_disponivel(void);
 void definir_dificuldade_musica(int e_fase_media);
 void definir_musica_ligada(int ligada);
 int tocar_musica(const char* arquivo);
 int tocar_sound_effect(const char* arquivo);
+// Música em loop que começa quando o efeito em curso acabar (ou já, se não houver)
+int tocar_musica_em_seguida(const char* arquivo);
 void parar_musica(void);
+// Estado publicado pela thread de áudio (não consulta o mixer)
 int musica_tocando(void);
+long comandos_audio_descartados(void);
+// Comandos retirados da fila pela thread de áudio; ler depois de finalizar_audio
+long comandos_audio_executados(void);
 void finalizar_audio(void);
 
-#endif
\ No newline at end of file
+// Medido a cada buffer na thread de mixagem: CPU para decodificar e mixar, fatia de um núcleo
+// e buffers atrasados (callback de pós-mixagem mais de meio buffer depois do esperado; é uma
+// inferência, não uma contagem de underruns do dispositivo). Ler depois de finalizar_audio
+void estatisticas_audio(const char **saida, long *buffers, double *media_ms, double *max_ms,
+                        double *cpu_percentual, long *atrasados);
+// --audio: toca `musica` (com um efeito no meio) por `segundos` e imprime as estatísticas
+int executar_bench_audio(int segundos, const char *musica);
+
+#endif
@@ -0,0 +1,136 @@
+#include "bancadas.h"
+#include "../eventos/eventos.h"
+#include "../escalonamento/escalonamento.h"
+
+// Operações O(1) da fila circular de espera
+static void fila_inserir(FilaEspera *f, int tedax_id, unsigned int ticket) {
+    if (f->qtd >= MAX_TEDAX) {
+        return;
+    }
+    int pos = (f->inicio + f->qtd) % MAX_TEDAX;
+    f->tedax_ids[pos] = tedax_id;
+    f->tickets[pos] = ticket;
+    f->qtd++;
+}
+
+// Remove um tedax do meio da fila preservando a ordem (fila tem no máximo MAX_TEDAX entradas)
+static void fila_remover_tedax(FilaEspera *f, int tedax_id) {
+    int escrita = 0;
+    for (int i = 0; i < f->qtd; i++) {
+        int pos = (f->inicio + i) % MAX_TEDAX;
+        if (f->tedax_ids[pos] == tedax_id) {
+            continue;
+        }
+        int destino = (f->inicio + escrita) % MAX_TEDAX;
+        f->tedax_ids[destino] = f->tedax_ids[pos];
+        f->tickets[destino] = f->tickets[pos];
+        escrita++;
+    }
+    f->qtd = escrita;
+}
+
+static void fila_limpar(FilaEspera *f) {
+    f->inicio = 0;
+    f->qtd = 0;
+}
+
+// Coloca o tedax para trabalhar na bancada (bancada já marcada como ocupada por ele)
+static void iniciar_tedax_na_bancada(GameState *g, int bancada_idx, int tedax_idx) {
+    Tedax *t = &g->tedax[tedax_idx];
+    Bancada *b = &g->bancadas[bancada_idx];
+
+    b->estado = BANCADA_OCUPADA;
+    b->tedax_ocupando = t->id;
+    g->bancadas_livres &= ~(1u << bancada_idx);
+
+    t->estado = TEDAX_OCUPADO;
+    t->bancada_atual = bancada_idx;
+    registrar_evento(EVENTO_BANCADA_OCUPADA, g->semente, t->id, b->id, -1, 0, NULL);
+
+    // O prazo do módulo entra na roda a partir deste instante
+    iniciar_contagem_modulo(g, tedax_idx);
+}
+
+void bancadas_inicializar(GameState *g, int qtd_bancadas) {
+    g->qtd_bancadas = qtd_bancadas;
+    g->bancadas_livres = 0;
+    for (int i = 0; i < qtd_bancadas; i++) {
+        g->bancadas[i].id = i + 1;
+        g->bancadas[i].estado = BANCADA_LIVRE;
+        g->bancadas[i].tedax_ocupando = -1;
+        fila_limpar(&g->bancadas[i].espera);
+        g->bancadas_livres |= 1u << i;
+    }
+    fila_limpar(&g->espera_global);
+    g->proximo_ticket_espera = 0;
+}
+
+int bancada_ocupar(GameState *g, int bancada_idx, int tedax_idx) {
+    if (bancada_idx < 0 || bancada_idx >= g->qtd_bancadas) {
+        return 0;
+    }
+    if (!(g->bancadas_livres & (1u << bancada_idx))) {
+        return 0;
+    }
+    iniciar_tedax_na_bancada(g, bancada_idx, tedax_idx);
+    return 1;
+}
+
+int bancada_ocupar_qualquer(GameState *g, int tedax_idx) {
+    unsigned int livres = g->bancadas_livres & ((1u << g->qtd_bancadas) - 1);
+    if (livres == 0) {
+        return -1;
+    }
+    int bancada_idx = __builtin_ctz(livres);
+    iniciar_tedax_na_bancada(g, bancada_idx, tedax_idx);
+    return bancada_idx;
+}
+
+void bancada_liberar(GameState *g, int bancada_idx) {
+    if (bancada_idx < 0 || bancada_idx >= g->qtd_bancadas) {
+        return;
+    }
+    Bancada *b = &g->bancadas[bancada_idx];
+    FilaEspera *local = &b->espera;
+    FilaEspera *global = &g->espera_global;
+    registrar_evento(EVENTO_BANCADA_LIBERADA, g->semente, -1, b->id, -1, 0, NULL);
+
+    // Entrega ao tedax que a política escolher entre a fila da bancada e a fila global
+    // (na FIFO, o que chegou primeiro)
+    const FilaEspera *origem = NULL;
+    int tedax_id = escolher_em_espera(g, local, global, &origem);
+
+    if (tedax_id >= 0) {
+        fila_remover_tedax(origem == local ? local : global, tedax_id);
+        iniciar_tedax_na_bancada(g, bancada_idx, tedax_id - 1);
+    } else {
+        b->estado = BANCADA_LIVRE;
+        b->tedax_ocupando = -1;
+        g->bancadas_livres |= 1u << bancada_idx;
+    }
+
+    pthread_cond_broadcast(&g->cond_bancada_disponivel);
+}
+
+void bancada_entrar_espera(GameState *g, int bancada_idx, int tedax_idx) {
+    Tedax *t = &g->tedax[tedax_idx];
+    FilaEspera *f = (bancada_idx >= 0 && bancada_idx < g->qtd_bancadas) ?
+                    &g->bancadas[bancada_idx].espera : &g->espera_global;
+
+    fila_inserir(f, t->id, g->proximo_ticket_espera++);
+    t->estado = TEDAX_ESPERANDO;
+    t->bancada_atual = (f == &g->espera_global) ? -1 : bancada_idx;
+}
+
+void bancada_sair_espera(GameState *g, int tedax_idx) {
+    Tedax *t = &g->tedax[tedax_idx];
+    if (t->estado != TEDAX_ESPERANDO) {
+        return;
+    }
+    if (t->bancada_atual >= 0 && t->bancada_atual < g->qtd_bancadas) {
+        fila_remover_tedax(&g->bancadas[t->bancada_atual].espera, t->id);
+    } else {
+        fila_remover_tedax(&g->espera_global, t->id);
+    }
+    t->bancada_atual = -1;
+}
@@ -0,0 +1,25 @@
+#ifndef BANCADAS_H
+#define BANCADAS_H
+
+#include "../game/game.h"
+
+// Alocador de bancadas: bitmap de livres + filas FIFO de espera (todas as operações exigem mutex_jogo)
+void bancadas_inicializar(GameState *g, int qtd_bancadas);
+
+// Tenta ocupar uma bancada específica; retorna 1 se o tedax passou a ocupá-la
+int bancada_ocupar(GameState *g, int bancada_idx, int tedax_idx);
+
+// Ocupa a bancada livre de menor índice; retorna o índice ou -1 se nenhuma estiver livre
+int bancada_ocupar_qualquer(GameState *g, int tedax_idx);
+
+// Libera a bancada, entregando-a diretamente ao tedax em espera escolhido pela política
+// da partida (na FIFO, o que espera há mais tempo)
+void bancada_liberar(GameState *g, int bancada_idx);
+
+// Coloca o tedax na fila de uma bancada (bancada_idx >= 0) ou na fila global (bancada_idx < 0)
+void bancada_entrar_espera(GameState *g, int bancada_idx, int tedax_idx);
+
+// Remove o tedax da fila em que estiver aguardando
+void bancada_sair_espera(GameState *g, int tedax_idx);
+
+#endif // BANCADAS_H
@@ -0,0 +1,306 @@
+#define _POSIX_C_SOURCE 200809L
+#include "ciclo.h"
+#include "../ui/ui.h"
+#include "../comum/comum.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <ncurses.h>
+
+#define TICKS_STRESS_CICLO 150      // 30s de partida: passa por geração de módulo no mural
+#define TOLERANCIA_RSS_KB 256       // Folga para páginas tocadas tarde pelo malloc/ncurses; vazamento por partida passa disso
+
+typedef enum {
+    PAPEL_MURAL,
+    PAPEL_ESTOQUE,
+    PAPEL_EXIBICAO,
+    PAPEL_COORDENADOR,
+    PAPEL_TEDAX
+} PapelThread;
+
+typedef struct {
+    PapelThread papel;
+    int tedax_idx;
+    pthread_t thread;
+} ThreadCiclo;
+
+#define MAX_THREADS_CICLO (4 + MAX_TEDAX)
+
+static struct {
+    GameState g;
+    TedaxArgs args_tedax[MAX_TEDAX];
+    ThreadCiclo threads[MAX_THREADS_CICLO];
+    int qtd_threads;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t cond_soltar;         // Estacionadas esperam a próxima geração
+    pthread_cond_t cond_estacionadas;   // Última a voltar avisa ciclo_estacionar_threads
+    unsigned int geracao;               // Muda a cada ciclo_soltar_threads
+    int na_partida;                     // Threads ainda rodando a partida atual
+    int encerrar;
+    long partidas;
+    int iniciado;
+} ciclo;
+
+// Tedax além da quantidade da partida ficam estacionados nela
+static int participa_da_partida(const ThreadCiclo *t) {
+    return t->papel != PAPEL_TEDAX || t->tedax_idx < ciclo.g.qtd_tedax;
+}
+
+// Corpo de cada thread: as mesmas funções de thread da partida, chamadas uma vez por
+// partida; elas retornam no fim da partida e a thread volta a estacionar
+static void* thread_ciclo(void *arg) {
+    ThreadCiclo *t = (ThreadCiclo*)arg;
+    unsigned int vista = 0;
+
+    pthread_mutex_lock(&ciclo.mutex);
+    while (1) {
+        while (!ciclo.encerrar && ciclo.geracao == vista) {
+            pthread_cond_wait(&ciclo.cond_soltar, &ciclo.mutex);
+        }
+        if (ciclo.encerrar) {
+            break;
+        }
+        vista = ciclo.geracao;
+        if (!participa_da_partida(t)) {
+            continue;
+        }
+        pthread_mutex_unlock(&ciclo.mutex);
+
+        switch (t->papel) {
+            case PAPEL_MURAL:
+                thread_mural(&ciclo.g);
+                break;
+            case PAPEL_ESTOQUE:
+                thread_estoque(&ciclo.g);
+                break;
+            case PAPEL_EXIBICAO:
+                thread_exibicao(&ciclo.g);
+                break;
+            case PAPEL_COORDENADOR:
+                thread_coordenador(&ciclo.g);
+                break;
+            case PAPEL_TEDAX:
+                thread_tedax(&ciclo.args_tedax[t->tedax_idx]);
+                break;
+        }
+
+        pthread_mutex_lock(&ciclo.mutex);
+        if (--ciclo.na_partida == 0) {
+            pthread_cond_signal(&ciclo.cond_estacionadas);
+        }
+    }
+    pthread_mutex_unlock(&ciclo.mutex);
+    return NULL;
+}
+
+void ciclo_iniciar(void) {
+    if (ciclo.iniciado) {
+        return;
+    }
+    criar_sincronizacao_jogo(&ciclo.g);
+    ciclo.g.jogo_rodando = 0;
+    pthread_mutex_init(&ciclo.mutex, NULL);
+    pthread_cond_init(&ciclo.cond_soltar, NULL);
+    pthread_cond_init(&ciclo.cond_estacionadas, NULL);
+    ciclo.geracao = 0;
+    ciclo.na_partida = 0;
+    ciclo.encerrar = 0;
+    ciclo.partidas = 0;
+
+    const PapelThread papeis[] = { PAPEL_MURAL, PAPEL_ESTOQUE, PAPEL_EXIBICAO, PAPEL_COORDENADOR };
+    ciclo.qtd_threads = 0;
+    for (int i = 0; i < 4; i++) {
+        ciclo.threads[ciclo.qtd_threads].papel = papeis[i];
+        ciclo.threads[ciclo.qtd_threads].tedax_idx = -1;
+        ciclo.qtd_threads++;
+    }
+    for (int i = 0; i < MAX_TEDAX; i++) {
+        ciclo.args_tedax[i].g = &ciclo.g;
+        ciclo.args_tedax[i].tedax_id = i;
+        ciclo.threads[ciclo.qtd_threads].papel = PAPEL_TEDAX;
+        ciclo.threads[ciclo.qtd_threads].tedax_idx = i;
+        ciclo.qtd_threads++;
+    }
+    for (int i = 0; i < ciclo.qtd_threads; i++) {
+        pthread_create(&ciclo.threads[i].thread, NULL, thread_ciclo, &ciclo.threads[i]);
+    }
+    ciclo.iniciado = 1;
+}
+
+// Com as threads estacionadas (fora de partida)
+void ciclo_encerrar(void) {
+    if (!ciclo.iniciado) {
+        return;
+    }
+    pthread_mutex_lock(&ciclo.mutex);
+    ciclo.encerrar = 1;
+    pthread_cond_broadcast(&ciclo.cond_soltar);
+    pthread_mutex_unlock(&ciclo.mutex);
+    for (int i = 0; i < ciclo.qtd_threads; i++) {
+        pthread_join(ciclo.threads[i].thread, NULL);
+    }
+    ciclo.qtd_threads = 0;
+
+    destruir_sincronizacao_jogo(&ciclo.g);
+    pthread_mutex_destroy(&ciclo.mutex);
+    pthread_cond_destroy(&ciclo.cond_soltar);
+    pthread_cond_destroy(&ciclo.cond_estacionadas);
+    ciclo.iniciado = 0;
+}
+
+GameState* ciclo_nova_partida(Dificuldade dificuldade, int num_tedax, int num_bancadas) {
+    reiniciar_jogo(&ciclo.g, dificuldade, num_tedax, num_bancadas);
+    return &ciclo.g;
+}
+
+void ciclo_soltar_threads(void) {
+    // Prazos vencidos na roda só avisam mural e tedax; o trabalho roda nas threads deles
+    ciclo.g.threads_da_partida = 1;
+
+    pthread_mutex_lock(&ciclo.mutex);
+    ciclo.na_partida = 0;
+    for (int i = 0; i < ciclo.qtd_threads; i++) {
+        ciclo.na_partida += participa_da_partida(&ciclo.threads[i]);
+    }
+    ciclo.geracao++;
+    pthread_cond_broadcast(&ciclo.cond_soltar);
+    pthread_mutex_unlock(&ciclo.mutex);
+}
+
+void ciclo_estacionar_threads(void) {
+    pthread_mutex_lock(&ciclo.mutex);
+    while (ciclo.na_partida > 0) {
+        pthread_cond_wait(&ciclo.cond_estacionadas, &ciclo.mutex);
+    }
+    pthread_mutex_unlock(&ciclo.mutex);
+}
+
+void ciclo_terminar_partida(void) {
+    terminar_jogo(&ciclo.g);
+    ciclo.partidas++;
+}
+
+void ciclo_estatisticas(int *threads, long *partidas) {
+    *threads = ciclo.qtd_threads;
+    *partidas = ciclo.partidas;
+}
+
+// --- Stress: memória e threads do processo ao longo de muitas partidas ---
+
+static long rss_kb(void) {
+    FILE *f = fopen("/proc/self/statm", "r");
+    long paginas = 0;
+    long residentes = 0;
+    if (!f) {
+        return -1;
+    }
+    if (fscanf(f, "%ld %ld", &paginas, &residentes) != 2) {
+        residentes = -1;
+    }
+    fclose(f);
+    return residentes < 0 ? -1 : residentes * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+static int threads_processo(void) {
+    FILE *f = fopen("/proc/self/status", "r");
+    char linha[128];
+    int threads = -1;
+    if (!f) {
+        return -1;
+    }
+    while (fgets(linha, sizeof(linha), f)) {
+        if (sscanf(linha, "Threads: %d", &threads) == 1) {
+            break;
+        }
+    }
+    fclose(f);
+    return threads;
+}
+
+int executar_stress_ciclo(long partidas) {
+    if (partidas < 1) {
+        partidas = 10000;
+    }
+
+    // Tela e teclado de verdade para exibição e coordenador, mas num terminal nulo
+    FILE *nulo = fopen("/dev/null", "r+");
+    if (!nulo) {
+        perror("/dev/null");
+        return 1;
+    }
+    SCREEN *tela = newterm("xterm", nulo, nulo);
+    if (!tela) {
+        fprintf(stderr, "Erro: terminal nulo indisponivel\n");
+        fclose(nulo);
+        return 1;
+    }
+    set_term(tela);
+    definir_entrada_bloqueante(0);
+
+    int threads_antes = threads_processo();
+    ciclo_iniciar();
+    printf("Stress do ciclo: %ld partidas (%d threads do ciclo)\n", partidas, ciclo.qtd_threads);
+    printf("%10s %10s %8s\n", "partidas", "rss_kb", "threads");
+
+    long rss_referencia = -1;
+    int threads_referencia = -1;
+    long passo = partidas / 10 > 0 ? partidas / 10 : 1;
+    struct timespec inicio, fim;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+
+    for (long p = 1; p <= partidas; p++) {
+        GameState *g = ciclo_nova_partida(DIFICULDADE_FACIL, 0, 0);
+        iniciar_tela_partida();
+        ciclo_soltar_threads();
+        // Pausas curtas: as threads soltas chegam a rodar (desenhar, ler teclado, gerar) antes do fim
+        dormir_partida(g, 1000000L);
+        for (int t = 0; t < TICKS_STRESS_CICLO; t++) {
+            pthread_mutex_lock(&g->mutex_jogo);
+            avancar_tick_partida(g);
+            pthread_mutex_unlock(&g->mutex_jogo);
+            if (t % 25 == 0) {
+                dormir_partida(g, 100000L);
+            }
+        }
+        pthread_mutex_lock(&g->mutex_jogo);
+        encerrar_partida(g, 0);
+        pthread_mutex_unlock(&g->mutex_jogo);
+        ciclo_estacionar_threads();
+        encerrar_tela_partida();
+        ciclo_terminar_partida();
+
+        if (p % passo == 0 || p == partidas) {
+            long rss = rss_kb();
+            int threads = threads_processo();
+            // Referência depois da primeira leva: caches do ncurses e do malloc já aquecidos
+            if (rss_referencia < 0) {
+                rss_referencia = rss;
+                threads_referencia = threads;
+            }
+            printf("%10ld %10ld %8d\n", p, rss, threads);
+            fflush(stdout);
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+    double segundos = ms_entre(&inicio, &fim) / 1000.0;
+    long rss_final = rss_kb();
+    int threads_final = threads_processo();
+
+    ciclo_encerrar();
+    int threads_depois = threads_processo();
+    endwin();
+    delscreen(tela);
+    fclose(nulo);
+
+    int estavel = threads_final == threads_referencia && rss_final - rss_referencia <= TOLERANCIA_RSS_KB &&
+                  threads_depois == threads_antes;
+    printf("%.2f s (%.0f partidas/s); rss %+ld kB e threads %+d desde a primeira leva; "
+           "%d thread(s) depois de encerrar (antes: %d): %s\n",
+           segundos, partidas / segundos, rss_final - rss_referencia, threads_final - threads_referencia,
+           threads_depois, threads_antes, estavel ? "estavel" : "INSTAVEL");
+    return estavel ? 0 : 1;
+}
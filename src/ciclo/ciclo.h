@@ -0,0 +1,32 @@
+#ifndef CICLO_H
+#define CICLO_H
+
+#include "../game/game.h"
+
+// Ciclo de vida das partidas interativas. Um único GameState e as threads da partida
+// (mural, estoque, exibição, coordenador e um tedax por vaga) são criados uma vez, em
+// ciclo_iniciar. Entre partidas as threads ficam estacionadas numa condição; cada partida
+// só reinicia o GameState no lugar e as solta. Nada é alocado nem recriado por partida, e
+// ciclo_encerrar libera tudo (threads, travas) numa ordem fixa.
+//
+// Uso por partida: ciclo_nova_partida -> (restaurar salvamento) -> ciclo_soltar_threads ->
+// ticks até o fim -> ciclo_estacionar_threads -> ciclo_terminar_partida.
+
+void ciclo_iniciar(void);
+void ciclo_encerrar(void);
+
+// GameState do ciclo, reiniciado e já com os módulos iniciais; threads ainda estacionadas
+GameState* ciclo_nova_partida(Dificuldade dificuldade, int num_tedax, int num_bancadas);
+void ciclo_soltar_threads(void);
+// Depois de encerrar_partida: espera as threads da partida voltarem ao estacionamento
+void ciclo_estacionar_threads(void);
+void ciclo_terminar_partida(void);
+
+// Threads do ciclo vivas e partidas jogadas desde ciclo_iniciar
+void ciclo_estatisticas(int *threads, long *partidas);
+
+// --ciclos: N partidas seguidas, com todas as threads e tela num terminal nulo; imprime
+// memória residente e threads do processo a cada 10% e retorna 0 se ficaram estáveis
+int executar_stress_ciclo(long partidas);
+
+#endif // CICLO_H
@@ -0,0 +1,33 @@
+#include "comum.h"
+#include <stdio.h>
+#include <stdarg.h>
+
+uint32_t fnv1a(const unsigned char *dados, size_t tamanho) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < tamanho; i++) {
+        h ^= dados[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+double ms_entre(const struct timespec *a, const struct timespec *b) {
+    return (b->tv_sec - a->tv_sec) * 1000.0 + (b->tv_nsec - a->tv_nsec) / 1000000.0;
+}
+
+void acrescentar(char *buffer, size_t tamanho, size_t *pos, const char *formato, ...) {
+    if (*pos >= tamanho) {
+        return;
+    }
+    va_list args;
+    va_start(args, formato);
+    int n = vsnprintf(buffer + *pos, tamanho - *pos, formato, args);
+    va_end(args);
+    if (n < 0) {
+        return;
+    }
+    *pos += (size_t)n;
+    if (*pos >= tamanho) {
+        *pos = tamanho - 1;
+    }
+}
@@ -0,0 +1,20 @@
+#ifndef COMUM_H
+#define COMUM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+// Pequenas rotinas usadas por mais de um módulo
+
+// Soma de verificação FNV-1a (32 bits) dos arquivos gravados pelo jogo
+uint32_t fnv1a(const unsigned char *dados, size_t tamanho);
+
+// Milissegundos de `a` até `b` (negativo se `b` vier antes)
+double ms_entre(const struct timespec *a, const struct timespec *b);
+
+// printf no fim de 'buffer' a partir de *pos, avançando *pos; o texto que não couber é
+// truncado (o buffer fica sempre terminado em '\0')
+void acrescentar(char *buffer, size_t tamanho, size_t *pos, const char *formato, ...);
+
+#endif // COMUM_H
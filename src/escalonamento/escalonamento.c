@@ -0,0 +1,219 @@
+#include "escalonamento.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+PoliticaEscalonamento politica_configurada(void) {
+    PoliticaEscalonamento politica = POLITICA_FIFO;
+    const char *valor = getenv("TEDAX_ESCALONAMENTO");
+    if (valor) {
+        politica_por_nome(valor, &politica);
+    }
+    return politica;
+}
+
+int politica_por_nome(const char *nome, PoliticaEscalonamento *politica) {
+    if (strcmp(nome, "fifo") == 0) {
+        *politica = POLITICA_FIFO;
+    } else if (strcmp(nome, "sjf") == 0) {
+        *politica = POLITICA_SJF;
+    } else if (strcmp(nome, "edf") == 0) {
+        *politica = POLITICA_EDF;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+const char* nome_politica(PoliticaEscalonamento politica) {
+    switch (politica) {
+        case POLITICA_SJF: return "sjf";
+        case POLITICA_EDF: return "edf";
+        default: return "fifo";
+    }
+}
+
+// Prazo da EDF: o segundo em que o módulo ficaria pronto se começasse ao aparecer no mural
+long chave_modulo(const GameState *g, int modulo_idx) {
+    const Modulo *mod = &g->modulos[modulo_idx];
+    switch (g->politica) {
+        case POLITICA_SJF: return mod->tempo_total;
+        case POLITICA_EDF: return (long)mod->criado_em + mod->tempo_total;
+        default: return 0;
+    }
+}
+
+int escolher_tedax(const GameState *g) {
+    for (int i = 0; i < g->qtd_tedax; i++) {
+        if (g->tedax[i].estado == TEDAX_LIVRE) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Índices crescem com a chegada ao mural: o primeiro de menor chave é o mais antigo
+int escolher_modulo(const GameState *g) {
+    int melhor = -1;
+    long chave_melhor = 0;
+    for (int i = 0; i < g->qtd_modulos; i++) {
+        if (g->quente.estado[i] != MOD_PENDENTE || g->quente.reservado[i]) {
+            continue;
+        }
+        long chave = chave_modulo(g, i);
+        if (melhor < 0 || chave < chave_melhor) {
+            melhor = i;
+            chave_melhor = chave;
+        }
+    }
+    return melhor;
+}
+
+int escolher_na_fila_tedax(const GameState *g, const Tedax *tedax) {
+    int melhor = 0;
+    long chave_melhor = 0;
+    for (int k = 0; k < tedax->qtd_fila; k++) {
+        int m = tedax->fila[(tedax->inicio_fila + k) % MAX_FILA_TEDAX].modulo_idx;
+        if (m < 0 || m >= g->qtd_modulos) {
+            return k;
+        }
+        long chave = chave_modulo(g, m);
+        if (k == 0 || chave < chave_melhor) {
+            melhor = k;
+            chave_melhor = chave;
+        }
+    }
+    return melhor;
+}
+
+int escolher_em_espera(const GameState *g, const FilaEspera *local, const FilaEspera *global,
+                       const FilaEspera **origem) {
+    const FilaEspera *filas[2] = { local, global };
+    int melhor = -1;
+    long chave_melhor = 0;
+    unsigned int ticket_melhor = 0;
+    *origem = NULL;
+
+    for (int f = 0; f < 2; f++) {
+        for (int k = 0; k < filas[f]->qtd; k++) {
+            int pos = (filas[f]->inicio + k) % MAX_TEDAX;
+            int tedax_id = filas[f]->tedax_ids[pos];
+            unsigned int ticket = filas[f]->tickets[pos];
+            int m = g->tedax[tedax_id - 1].modulo_atual;
+            long chave = (m >= 0 && m < g->qtd_modulos) ? chave_modulo(g, m) : 0;
+            // Tickets dão a volta: compara pela diferença, como bancada_liberar fazia
+            if (melhor < 0 || chave < chave_melhor ||
+                (chave == chave_melhor && (int)(ticket - ticket_melhor) < 0)) {
+                melhor = tedax_id;
+                chave_melhor = chave;
+                ticket_melhor = ticket;
+                *origem = filas[f];
+            }
+        }
+    }
+    return melhor;
+}
+
+// --- Simulação: as três políticas nas mesmas partidas ---
+
+#define SEMENTE_BASE_SIMULACAO 1000u
+
+typedef struct {
+    long resolvidos;
+    long ticks;                 // Ticks de partida somados
+    long ticks_bancada;         // Ticks × bancadas
+    long ticks_bancada_livre;
+    long soma_latencia;         // tempo_solucao dos resolvidos (s)
+    int vitorias;
+} ResultadoPolitica;
+
+// Tedax ocupado (não à espera: um comando trocaria o módulo dele) com a menor fila com espaço
+static int tedax_com_menor_fila(const GameState *g) {
+    int melhor = -1;
+    for (int i = 0; i < g->qtd_tedax; i++) {
+        const Tedax *t = &g->tedax[i];
+        if (t->estado != TEDAX_OCUPADO || t->qtd_fila >= t->capacidade_fila) {
+            continue;
+        }
+        if (melhor < 0 || t->qtd_fila < g->tedax[melhor].qtd_fila) {
+            melhor = i;
+        }
+    }
+    return melhor;
+}
+
+// Robô: despacha todo módulo pendente assim que houver vaga, sempre com a resposta certa.
+// Módulo e ordem das filas ficam com a política; o robô só escolhe para qual fila mandar
+static void robo_despachar(GameState *g) {
+    int m;
+    while ((m = escolher_modulo(g)) >= 0) {
+        int t = escolher_tedax(g);
+        if (t < 0) {
+            t = tedax_com_menor_fila(g);
+        }
+        if (t < 0) {
+            return;
+        }
+        char comando[64];
+        snprintf(comando, sizeof(comando), "T%dM%d:%s", g->tedax[t].id, g->quente.id[m],
+                 g->modulos[m].instrucao_correta);
+        if (!executar_comando(g, comando)) {
+            return;
+        }
+    }
+}
+
+static void simular_partida(GameState *g, ResultadoPolitica *r) {
+    unsigned int todas = (1u << g->qtd_bancadas) - 1;
+    int terminou = 0;
+
+    pthread_mutex_lock(&g->mutex_jogo);
+    while (!terminou) {
+        robo_despachar(g);
+        terminou = avancar_tick_partida(g);
+        r->ticks++;
+        r->ticks_bancada += g->qtd_bancadas;
+        r->ticks_bancada_livre += __builtin_popcount(g->bancadas_livres & todas);
+    }
+    for (int i = 0; i < g->qtd_modulos; i++) {
+        if (g->quente.estado[i] == MOD_RESOLVIDO) {
+            r->resolvidos++;
+            r->soma_latencia += g->modulos[i].tempo_solucao;
+        }
+    }
+    r->vitorias += todos_modulos_resolvidos(g) && g->qtd_modulos > 0;
+    pthread_mutex_unlock(&g->mutex_jogo);
+}
+
+int executar_simulacao_escalonamento(int partidas, Dificuldade dificuldade) {
+    if (partidas < 1) {
+        partidas = 200;
+    }
+    static GameState g;
+    const PoliticaEscalonamento politicas[] = { POLITICA_FIFO, POLITICA_SJF, POLITICA_EDF };
+
+    criar_sincronizacao_jogo(&g);
+    printf("Escalonamento: %d partidas (%s) por politica, sementes %u a %u\n", partidas,
+           nome_dificuldade(dificuldade), SEMENTE_BASE_SIMULACAO + 1, SEMENTE_BASE_SIMULACAO + partidas);
+    printf("%-8s %12s %12s %14s %10s\n", "politica", "modulos/min", "bancada_ociosa", "latencia_media", "vitorias");
+
+    for (size_t p = 0; p < sizeof(politicas) / sizeof(politicas[0]); p++) {
+        ResultadoPolitica r = {0};
+        for (int s = 1; s <= partidas; s++) {
+            reiniciar_jogo_semente(&g, dificuldade, 0, 0, SEMENTE_BASE_SIMULACAO + (unsigned int)s);
+            g.politica = politicas[p];
+            simular_partida(&g, &r);
+            terminar_jogo(&g);
+        }
+
+        double minutos = r.ticks / (double)TICKS_POR_SEGUNDO / 60.0;
+        printf("%-8s %12.2f %13.1f%% %13.1fs %6d/%d\n", nome_politica(politicas[p]),
+               minutos > 0 ? r.resolvidos / minutos : 0.0,
+               r.ticks_bancada > 0 ? 100.0 * r.ticks_bancada_livre / r.ticks_bancada : 0.0,
+               r.resolvidos > 0 ? (double)r.soma_latencia / r.resolvidos : 0.0,
+               r.vitorias, partidas);
+    }
+
+    destruir_sincronizacao_jogo(&g);
+    return 0;
+}
@@ -0,0 +1,36 @@
+#ifndef ESCALONAMENTO_H
+#define ESCALONAMENTO_H
+
+#include "../game/game.h"
+
+// Políticas de despacho: quem decide o módulo de um comando sem M, o próximo item da fila
+// de um tedax e qual tedax à espera recebe a bancada liberada. As três políticas ordenam
+// pela chave do módulo (0 na FIFO, tempo_total na SJF, criado_em + tempo_total na EDF) e
+// desempatam pela ordem de chegada, então a FIFO é exatamente o despacho de antes.
+// Tedax são todos iguais: o de um comando sem T é sempre o primeiro livre.
+// Todas as funções exigem mutex_jogo travado.
+
+// TEDAX_ESCALONAMENTO=fifo|sjf|edf, lida a cada partida (padrão fifo)
+PoliticaEscalonamento politica_configurada(void);
+int politica_por_nome(const char *nome, PoliticaEscalonamento *politica);
+const char* nome_politica(PoliticaEscalonamento politica);
+
+// Menor chave sai primeiro
+long chave_modulo(const GameState *g, int modulo_idx);
+
+// Primeiro tedax livre; -1 se nenhum
+int escolher_tedax(const GameState *g);
+// Módulo pendente e sem reserva de menor chave; -1 se nenhum
+int escolher_modulo(const GameState *g);
+// Posição (a partir do início) do próximo item a sair da fila do tedax; itens inválidos saem antes
+int escolher_na_fila_tedax(const GameState *g, const Tedax *tedax);
+// Tedax (id) que recebe a bancada entre as duas filas de espera, e de qual fila; -1 se vazias
+int escolher_em_espera(const GameState *g, const FilaEspera *local, const FilaEspera *global,
+                       const FilaEspera **origem);
+
+// --escalonamento: `partidas` partidas sem tela por política, com as mesmas sementes, jogadas
+// por um robô que deixa a escolha de módulo e de fila para a política; imprime módulos
+// resolvidos por minuto e ociosidade das bancadas de cada uma
+int executar_simulacao_escalonamento(int partidas, Dificuldade dificuldade);
+
+#endif // ESCALONAMENTO_H
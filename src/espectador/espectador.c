@@ -0,0 +1,473 @@
+#define _GNU_SOURCE
+#include "espectador.h"
+#include "../modulos/modulos.h"
+#include "../comum/comum.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define MAX_ESPECTADORES 32
+#define TAMANHO_SAIDA_ESPECTADOR 65536
+#define TAMANHO_DELTA 32768
+#define MAX_MODULOS_RETRATO MAX_MODULOS
+#define INTERVALO_RETRATO_MS 200
+
+// Cópia compacta do que o espectador enxerga; a diferença entre dois retratos vira o delta
+typedef struct {
+    int ativo;
+    Dificuldade dificuldade;
+    int tempo;
+    int resolvidos;
+    int erros;
+
+    int qtd_modulos;
+    struct {
+        int id;
+        TipoModulo tipo;
+        EstadoModulo estado;
+        char info[48];
+    } modulos[MAX_MODULOS_RETRATO];
+
+    int qtd_tedax;
+    struct {
+        EstadoTedax estado;
+        int modulo_id;
+        int bancada_id;
+    } tedax[MAX_TEDAX];
+
+    int qtd_bancadas;
+    struct {
+        EstadoBancada estado;
+        int tedax_id;
+    } bancadas[MAX_BANCADAS];
+} Retrato;
+
+typedef struct {
+    int fd;
+    int dessincronizado;    // Buffer estourou: recebe o estado completo quando voltar a ler
+    char saida[TAMANHO_SAIDA_ESPECTADOR];
+    size_t len_saida;
+} Espectador;
+
+// Partida transmitida: trocada pela thread principal, lida pela thread de transmissão
+static pthread_mutex_t mutex_partida = PTHREAD_MUTEX_INITIALIZER;
+static GameState *partida_atual = NULL;
+static unsigned geracao_partida = 0;
+
+static pthread_t thread_transmissao_id;
+static int transmissao_ativa = 0;
+static int fd_escuta = -1;
+static int pipe_parar[2] = { -1, -1 };
+static char caminho_transmissao[108];
+
+static Espectador *espectadores[MAX_ESPECTADORES];
+static int qtd_espectadores = 0;
+
+static Retrato retratos[2];
+static char delta[TAMANHO_DELTA];
+
+// A lista de módulos só cresce durante uma partida; encolher ou trocar ids (partida restaurada
+// de um retrato salvo) invalida as diferenças contra o retrato anterior
+static int continua_retrato(const GameState *g, const Retrato *anterior) {
+    if (!anterior->ativo || g->qtd_modulos < anterior->qtd_modulos) {
+        return 0;
+    }
+    for (int i = 0; i < anterior->qtd_modulos; i++) {
+        if (g->quente.id[i] != anterior->modulos[i].id) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Copia o estado sob mutex_jogo; a formatação do texto dos módulos novos fica para depois.
+// Retorna 0 se o retrato não continua o anterior (os módulos vêm todos como novos)
+static int tirar_retrato(const GameState *g, const Retrato *anterior, Retrato *r, Modulo *novos, int *qtd_novos) {
+    int continua = continua_retrato(g, anterior);
+    r->ativo = 1;
+    r->dificuldade = g->dificuldade;
+    r->tempo = g->tempo_restante;
+    r->erros = g->erros_cometidos;
+    r->resolvidos = contar_modulos_resolvidos(g);
+
+    r->qtd_modulos = g->qtd_modulos < MAX_MODULOS_RETRATO ? g->qtd_modulos : MAX_MODULOS_RETRATO;
+    int base = continua ? anterior->qtd_modulos : 0;
+    *qtd_novos = 0;
+    for (int i = 0; i < r->qtd_modulos; i++) {
+        r->modulos[i].id = g->quente.id[i];
+        r->modulos[i].tipo = g->modulos[i].tipo;
+        r->modulos[i].estado = g->quente.estado[i];
+        if (i >= base) {
+            novos[(*qtd_novos)++] = g->modulos[i];
+        }
+    }
+
+    r->qtd_tedax = g->qtd_tedax;
+    for (int i = 0; i < g->qtd_tedax; i++) {
+        const Tedax *t = &g->tedax[i];
+        r->tedax[i].estado = t->estado;
+        r->tedax[i].modulo_id = t->modulo_atual >= 0 ? g->quente.id[t->modulo_atual] : 0;
+        r->tedax[i].bancada_id = t->bancada_atual >= 0 ? g->bancadas[t->bancada_atual].id : 0;
+    }
+
+    r->qtd_bancadas = g->qtd_bancadas;
+    for (int i = 0; i < g->qtd_bancadas; i++) {
+        r->bancadas[i].estado = g->bancadas[i].estado;
+        r->bancadas[i].tedax_id = g->bancadas[i].tedax_ocupando > 0 ? g->bancadas[i].tedax_ocupando : 0;
+    }
+    return continua;
+}
+
+static void escrever_tedax(const Retrato *r, int i, char *buffer, size_t tamanho, size_t *pos) {
+    acrescentar(buffer, tamanho, pos, "T id=%d estado=%s modulo=%d bancada=%d\n", i + 1,
+                nome_estado_tedax(r->tedax[i].estado), r->tedax[i].modulo_id, r->tedax[i].bancada_id);
+}
+
+static void escrever_bancada(const Retrato *r, int i, char *buffer, size_t tamanho, size_t *pos) {
+    acrescentar(buffer, tamanho, pos, "B id=%d estado=%s tedax=%d\n", i + 1,
+                r->bancadas[i].estado == BANCADA_LIVRE ? "LIVRE" : "OCUPADA", r->bancadas[i].tedax_id);
+}
+
+static void escrever_modulo_novo(const Retrato *r, int i, char *buffer, size_t tamanho, size_t *pos) {
+    acrescentar(buffer, tamanho, pos, "+M id=%d tipo=%s info=%s\n",
+                r->modulos[i].id, nome_tipo_modulo(r->modulos[i].tipo), r->modulos[i].info);
+    if (r->modulos[i].estado != MOD_PENDENTE) {
+        acrescentar(buffer, tamanho, pos, "M id=%d estado=%s\n",
+                    r->modulos[i].id, nome_estado_modulo(r->modulos[i].estado));
+    }
+}
+
+static void escrever_relogio(const Retrato *r, char *buffer, size_t tamanho, size_t *pos) {
+    acrescentar(buffer, tamanho, pos, "R tempo=%d resolvidos=%d erros=%d\n", r->tempo, r->resolvidos, r->erros);
+}
+
+// Estado completo: enviado a quem conecta, a quem perdeu deltas e no início de cada partida
+static size_t escrever_completo(const Retrato *r, char *buffer, size_t tamanho) {
+    size_t pos = 0;
+    buffer[0] = '\0';
+    if (!r->ativo) {
+        return 0;
+    }
+    acrescentar(buffer, tamanho, &pos, "PARTIDA dificuldade=%s tedax=%d bancadas=%d\n",
+                nome_dificuldade(r->dificuldade), r->qtd_tedax, r->qtd_bancadas);
+    escrever_relogio(r, buffer, tamanho, &pos);
+    for (int i = 0; i < r->qtd_bancadas; i++) {
+        escrever_bancada(r, i, buffer, tamanho, &pos);
+    }
+    for (int i = 0; i < r->qtd_tedax; i++) {
+        escrever_tedax(r, i, buffer, tamanho, &pos);
+    }
+    for (int i = 0; i < r->qtd_modulos; i++) {
+        escrever_modulo_novo(r, i, buffer, tamanho, &pos);
+    }
+    return pos;
+}
+
+static size_t escrever_diferencas(const Retrato *a, const Retrato *r, char *buffer, size_t tamanho) {
+    size_t pos = 0;
+    buffer[0] = '\0';
+
+    for (int i = a->qtd_modulos; i < r->qtd_modulos; i++) {
+        escrever_modulo_novo(r, i, buffer, tamanho, &pos);
+    }
+    for (int i = 0; i < a->qtd_modulos; i++) {
+        if (a->modulos[i].estado != r->modulos[i].estado) {
+            acrescentar(buffer, tamanho, &pos, "M id=%d estado=%s\n",
+                        r->modulos[i].id, nome_estado_modulo(r->modulos[i].estado));
+        }
+    }
+    for (int i = 0; i < r->qtd_bancadas; i++) {
+        if (a->bancadas[i].estado != r->bancadas[i].estado || a->bancadas[i].tedax_id != r->bancadas[i].tedax_id) {
+            escrever_bancada(r, i, buffer, tamanho, &pos);
+        }
+    }
+    for (int i = 0; i < r->qtd_tedax; i++) {
+        if (a->tedax[i].estado != r->tedax[i].estado || a->tedax[i].modulo_id != r->tedax[i].modulo_id ||
+            a->tedax[i].bancada_id != r->tedax[i].bancada_id) {
+            escrever_tedax(r, i, buffer, tamanho, &pos);
+        }
+    }
+    if (a->tempo != r->tempo || a->resolvidos != r->resolvidos || a->erros != r->erros) {
+        escrever_relogio(r, buffer, tamanho, &pos);
+    }
+    return pos;
+}
+
+static void remover_espectador(int k) {
+    close(espectadores[k]->fd);
+    free(espectadores[k]);
+    espectadores[k] = espectadores[--qtd_espectadores];
+}
+
+// Envia o que o socket aceitar sem bloquear; retorna 0 se o espectador caiu
+static int descarregar_espectador(Espectador *e) {
+    while (e->len_saida > 0) {
+        ssize_t n = send(e->fd, e->saida, e->len_saida, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        memmove(e->saida, e->saida + n, e->len_saida - (size_t)n);
+        e->len_saida -= (size_t)n;
+    }
+    return 1;
+}
+
+// Enfileira sem nunca esperar: se não couber, descarta o pendente (menos a linha já
+// começada) e marca o espectador para receber o estado completo
+static void enfileirar(Espectador *e, const char *dados, size_t tamanho) {
+    if (e->dessincronizado || tamanho == 0) {
+        return;
+    }
+    if (e->len_saida + tamanho > sizeof(e->saida)) {
+        char *fim_linha = memchr(e->saida, '\n', e->len_saida);
+        e->len_saida = fim_linha ? (size_t)(fim_linha - e->saida) + 1 : 0;
+        e->dessincronizado = 1;
+        return;
+    }
+    memcpy(e->saida + e->len_saida, dados, tamanho);
+    e->len_saida += tamanho;
+}
+
+static void aceitar_espectadores(const Retrato *atual) {
+    while (1) {
+        int fd = accept4(fd_escuta, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        if (qtd_espectadores >= MAX_ESPECTADORES) {
+            close(fd);
+            continue;
+        }
+        Espectador *e = calloc(1, sizeof(Espectador));
+        e->fd = fd;
+        e->len_saida = escrever_completo(atual, e->saida, sizeof(e->saida));
+        espectadores[qtd_espectadores++] = e;
+    }
+}
+
+static void* thread_transmissao(void *arg) {
+    (void)arg;
+    static Modulo novos[MAX_MODULOS_RETRATO];
+    int atual = 0;
+    unsigned geracao_vista = 0;
+    retratos[0].ativo = 0;
+    retratos[1].ativo = 0;
+
+    struct timespec proximo;
+    clock_gettime(CLOCK_MONOTONIC, &proximo);
+
+    while (1) {
+        struct pollfd fds[2 + MAX_ESPECTADORES];
+        int nfds = 0;
+        fds[nfds++] = (struct pollfd){ .fd = pipe_parar[0], .events = POLLIN };
+        fds[nfds++] = (struct pollfd){ .fd = fd_escuta, .events = POLLIN };
+        for (int k = 0; k < qtd_espectadores; k++) {
+            short eventos = POLLIN;
+            if (espectadores[k]->len_saida > 0 || espectadores[k]->dessincronizado) {
+                eventos |= POLLOUT;
+            }
+            fds[nfds++] = (struct pollfd){ .fd = espectadores[k]->fd, .events = eventos };
+        }
+
+        struct timespec agora;
+        clock_gettime(CLOCK_MONOTONIC, &agora);
+        long espera_ms = (proximo.tv_sec - agora.tv_sec) * 1000 + (proximo.tv_nsec - agora.tv_nsec) / 1000000;
+        if (espera_ms < 0) {
+            espera_ms = 0;
+        }
+
+        if (poll(fds, (nfds_t)nfds, (int)espera_ms) < 0 && errno != EINTR) {
+            break;
+        }
+        if (fds[0].revents) {
+            break;
+        }
+        if (fds[1].revents & POLLIN) {
+            aceitar_espectadores(&retratos[atual]);
+        }
+
+        // Espectadores: descartar entrada, enviar pendente, ressincronizar ou remover
+        for (int k = nfds - 3; k >= 0; k--) {
+            Espectador *e = espectadores[k];
+            short revents = fds[2 + k].revents;
+            if (revents & (POLLERR | POLLHUP)) {
+                remover_espectador(k);
+                continue;
+            }
+            if (revents & POLLIN) {
+                char descarte[256];
+                if (read(e->fd, descarte, sizeof(descarte)) == 0) {
+                    remover_espectador(k);
+                    continue;
+                }
+            }
+            if (revents & POLLOUT) {
+                if (!descarregar_espectador(e)) {
+                    remover_espectador(k);
+                    continue;
+                }
+                if (e->dessincronizado && e->len_saida == 0) {
+                    e->dessincronizado = 0;
+                    e->len_saida = escrever_completo(&retratos[atual], e->saida, sizeof(e->saida));
+                }
+            }
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &agora);
+        if (agora.tv_sec < proximo.tv_sec || (agora.tv_sec == proximo.tv_sec && agora.tv_nsec < proximo.tv_nsec)) {
+            continue;
+        }
+        proximo.tv_nsec += INTERVALO_RETRATO_MS * 1000000L;
+        if (proximo.tv_nsec >= 1000000000L) {
+            proximo.tv_sec++;
+            proximo.tv_nsec -= 1000000000L;
+        }
+
+        // Novo retrato: o jogo só fica travado durante a cópia
+        Retrato *anterior = &retratos[atual];
+        Retrato *novo = &retratos[1 - atual];
+        int qtd_novos = 0;
+        int nova_partida = 0;
+
+        pthread_mutex_lock(&mutex_partida);
+        if (partida_atual) {
+            if (geracao_vista != geracao_partida) {
+                geracao_vista = geracao_partida;
+                nova_partida = 1;
+                anterior->ativo = 0;
+            }
+            pthread_mutex_lock(&partida_atual->mutex_jogo);
+            if (!tirar_retrato(partida_atual, anterior, novo, novos, &qtd_novos)) {
+                // Primeiro retrato ou partida restaurada: os espectadores recebem o estado completo
+                nova_partida = 1;
+            }
+            pthread_mutex_unlock(&partida_atual->mutex_jogo);
+        } else {
+            novo->ativo = 0;
+        }
+        pthread_mutex_unlock(&mutex_partida);
+
+        for (int i = 0; i < qtd_novos; i++) {
+            Modulo *mod = &novos[i];
+            obter_info_exibicao_modulo(mod, novo->modulos[novo->qtd_modulos - qtd_novos + i].info,
+                                       sizeof(novo->modulos[0].info));
+        }
+        for (int i = 0; i < novo->qtd_modulos - qtd_novos; i++) {
+            memcpy(novo->modulos[i].info, anterior->modulos[i].info, sizeof(novo->modulos[i].info));
+        }
+
+        size_t n;
+        if (novo->ativo && nova_partida) {
+            n = escrever_completo(novo, delta, sizeof(delta));
+        } else if (novo->ativo) {
+            n = escrever_diferencas(anterior, novo, delta, sizeof(delta));
+        } else if (anterior->ativo) {
+            n = (size_t)snprintf(delta, sizeof(delta), "FIM\n");
+        } else {
+            n = 0;
+        }
+        atual = 1 - atual;
+
+        for (int k = qtd_espectadores - 1; k >= 0; k--) {
+            enfileirar(espectadores[k], delta, n);
+            if (!descarregar_espectador(espectadores[k])) {
+                remover_espectador(k);
+            }
+        }
+    }
+
+    while (qtd_espectadores > 0) {
+        remover_espectador(qtd_espectadores - 1);
+    }
+    return NULL;
+}
+
+int iniciar_transmissao(const char *caminho_socket) {
+    if (transmissao_ativa) {
+        return 1;
+    }
+
+    struct sockaddr_un endereco;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    strncpy(endereco.sun_path, caminho_socket, sizeof(endereco.sun_path) - 1);
+    strncpy(caminho_transmissao, endereco.sun_path, sizeof(caminho_transmissao) - 1);
+
+    fd_escuta = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd_escuta < 0) {
+        return 0;
+    }
+    unlink(caminho_socket);
+    if (bind(fd_escuta, (struct sockaddr*)&endereco, sizeof(endereco)) < 0 ||
+        listen(fd_escuta, 16) < 0 || pipe(pipe_parar) < 0) {
+        close(fd_escuta);
+        fd_escuta = -1;
+        return 0;
+    }
+
+    if (pthread_create(&thread_transmissao_id, NULL, thread_transmissao, NULL) != 0) {
+        close(fd_escuta);
+        close(pipe_parar[0]);
+        close(pipe_parar[1]);
+        fd_escuta = -1;
+        return 0;
+    }
+    transmissao_ativa = 1;
+    return 1;
+}
+
+// Chamada com a partida já inicializada (g) e com NULL antes de finalizar_jogo
+void transmissao_definir_partida(GameState *g) {
+    pthread_mutex_lock(&mutex_partida);
+    partida_atual = g;
+    if (g) {
+        geracao_partida++;
+    }
+    pthread_mutex_unlock(&mutex_partida);
+}
+
+void parar_transmissao(void) {
+    if (!transmissao_ativa) {
+        return;
+    }
+    if (write(pipe_parar[1], "x", 1) < 0) {
+        return;
+    }
+    pthread_join(thread_transmissao_id, NULL);
+    close(pipe_parar[0]);
+    close(pipe_parar[1]);
+    close(fd_escuta);
+    unlink(caminho_transmissao);
+    fd_escuta = -1;
+    transmissao_ativa = 0;
+}
+
+int executar_espectador(const char *caminho_socket) {
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    struct sockaddr_un endereco;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    strncpy(endereco.sun_path, caminho_socket, sizeof(endereco.sun_path) - 1);
+    if (fd < 0 || connect(fd, (struct sockaddr*)&endereco, sizeof(endereco)) < 0) {
+        perror("connect");
+        return 1;
+    }
+
+    char buffer[4096];
+    ssize_t lidos;
+    while ((lidos = read(fd, buffer, sizeof(buffer))) > 0) {
+        fwrite(buffer, 1, (size_t)lidos, stdout);
+        fflush(stdout);
+    }
+
+    close(fd);
+    return 0;
+}
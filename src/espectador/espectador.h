@@ -0,0 +1,28 @@
+#ifndef ESPECTADOR_H
+#define ESPECTADOR_H
+
+#include "../game/game.h"
+
+// Transmissão para espectadores somente-leitura via socket Unix.
+// Uma thread própria tira um retrato compacto do jogo a cada tick, compara com o
+// anterior e envia só as diferenças (linhas de texto):
+//   PARTIDA dificuldade=<d> tedax=<n> bancadas=<n>   início de partida (seguido do estado completo)
+//   +M id=<n> tipo=<t> info=<...>                    módulo adicionado
+//   M id=<n> estado=<e>                              transição de estado do módulo
+//   T id=<n> estado=<e> modulo=<id> bancada=<id>     atribuição de tedax
+//   B id=<n> estado=<e> tedax=<id>                   ocupação de bancada
+//   R tempo=<s> resolvidos=<n> erros=<n>             relógio/placar
+//   FIM                                              fim da partida
+// Espectadores lentos nunca seguram o jogo: o buffer deles é descartado e eles
+// recebem o estado completo de novo quando voltarem a ler.
+
+#define SOCKET_ESPECTADOR_PADRAO "/tmp/tedax_espectador.sock"
+
+int iniciar_transmissao(const char *caminho_socket);
+void transmissao_definir_partida(GameState *g);
+void parar_transmissao(void);
+
+// Cliente espectador: imprime as diferenças recebidas
+int executar_espectador(const char *caminho_socket);
+
+#endif // ESPECTADOR_H
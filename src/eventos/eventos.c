@@ -0,0 +1,312 @@
+#define _POSIX_C_SOURCE 200809L
+#include "eventos.h"
+#include "../game/game.h"
+#include <stdatomic.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define MASCARA_ANEL (CAPACIDADE_ANEL_EVENTOS - 1)
+#define ESPERA_REGISTRO_NS 50000000L   // Período da thread de registro
+
+_Static_assert(sizeof(RegistroEvento) == 64, "RegistroEvento deve ter 64 bytes");
+_Static_assert((CAPACIDADE_ANEL_EVENTOS & MASCARA_ANEL) == 0, "capacidade do anel deve ser potência de 2");
+
+enum { ANEL_LIVRE, ANEL_EM_USO, ANEL_ABANDONADO };
+
+// Anel de produtor único: só a thread dona avança a cabeça, só a thread de registro
+// avança a cauda. Cabeça e cauda em linhas de cache separadas.
+typedef struct {
+    _Alignas(64) atomic_uint cabeca;
+    _Alignas(64) atomic_uint cauda;
+    atomic_int estado;                  // LIVRE, EM_USO ou ABANDONADO (a thread dona terminou)
+    atomic_uint perdidos;
+    RegistroEvento registros[CAPACIDADE_ANEL_EVENTOS];
+} AnelEventos;
+
+typedef struct {
+    char magica[8];
+    uint32_t versao;
+    uint32_t tamanho_registro;
+} CabecalhoEventos;
+
+static const char MAGICA_EVENTOS[8] = { 'T', 'E', 'D', 'A', 'X', 'E', 'V', 'T' };
+
+static AnelEventos aneis[MAX_ANEIS_EVENTOS];
+static _Thread_local AnelEventos *anel_da_thread = NULL;
+static pthread_key_t chave_anel;                // Destrutor devolve o anel quando a thread sai
+static pthread_once_t chave_criada = PTHREAD_ONCE_INIT;
+static atomic_uint perdidos_sem_anel;
+
+static atomic_int registro_ativo = 0;
+static pthread_t thread_registro_id;
+static char caminho_eventos[256];
+static int fd_eventos = -1;                     // -1 = ainda não aberto; -2 = falhou
+static RegistroEvento lote[CAPACIDADE_ANEL_EVENTOS];
+
+static void abandonar_anel(void *anel) {
+    atomic_store_explicit(&((AnelEventos*)anel)->estado, ANEL_ABANDONADO, memory_order_release);
+}
+
+static void criar_chave_anel(void) {
+    pthread_key_create(&chave_anel, abandonar_anel);
+}
+
+static AnelEventos *obter_anel(void) {
+    if (anel_da_thread) {
+        return anel_da_thread;
+    }
+    for (int i = 0; i < MAX_ANEIS_EVENTOS; i++) {
+        int esperado = ANEL_LIVRE;
+        if (atomic_compare_exchange_strong(&aneis[i].estado, &esperado, ANEL_EM_USO)) {
+            anel_da_thread = &aneis[i];
+            pthread_setspecific(chave_anel, anel_da_thread);
+            return anel_da_thread;
+        }
+    }
+    return NULL;
+}
+
+void registrar_evento(TipoEvento tipo, uint32_t partida, int tedax, int bancada, int modulo,
+                      int valor, const char *texto) {
+    if (!atomic_load_explicit(&registro_ativo, memory_order_relaxed)) {
+        return;
+    }
+    AnelEventos *a = obter_anel();
+    if (!a) {
+        atomic_fetch_add_explicit(&perdidos_sem_anel, 1, memory_order_relaxed);
+        return;
+    }
+
+    unsigned int cabeca = atomic_load_explicit(&a->cabeca, memory_order_relaxed);
+    unsigned int cauda = atomic_load_explicit(&a->cauda, memory_order_acquire);
+    if (cabeca - cauda >= CAPACIDADE_ANEL_EVENTOS) {
+        atomic_fetch_add_explicit(&a->perdidos, 1, memory_order_relaxed);
+        return;
+    }
+
+    RegistroEvento *r = &a->registros[cabeca & MASCARA_ANEL];
+    struct timespec agora;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    r->instante_ns = (uint64_t)agora.tv_sec * 1000000000u + (uint64_t)agora.tv_nsec;
+    r->partida = partida;
+    r->modulo = modulo;
+    r->valor = valor;
+    r->tipo = (uint8_t)tipo;
+    r->anel = (uint8_t)(a - aneis);
+    r->tedax = (int8_t)tedax;
+    r->bancada = (int8_t)bancada;
+    memset(r->texto, 0, sizeof(r->texto));
+    if (texto) {
+        size_t n = strlen(texto);
+        memcpy(r->texto, texto, n < sizeof(r->texto) ? n : sizeof(r->texto));
+    }
+    atomic_store_explicit(&a->cabeca, cabeca + 1, memory_order_release);
+}
+
+// Acrescenta registros ao arquivo, abrindo-o (e escrevendo o cabeçalho) na primeira vez
+static void gravar_registros(const RegistroEvento *registros, size_t qtd) {
+    if (qtd == 0 || fd_eventos == -2) {
+        return;
+    }
+    if (fd_eventos == -1) {
+        fd_eventos = open(caminho_eventos, O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd_eventos < 0) {
+            fd_eventos = -2;
+            return;
+        }
+        if (lseek(fd_eventos, 0, SEEK_END) == 0) {
+            CabecalhoEventos c;
+            memcpy(c.magica, MAGICA_EVENTOS, sizeof(c.magica));
+            c.versao = VERSAO_EVENTOS;
+            c.tamanho_registro = sizeof(RegistroEvento);
+            if (write(fd_eventos, &c, sizeof(c)) != (ssize_t)sizeof(c)) {
+                close(fd_eventos);
+                fd_eventos = -2;
+                return;
+            }
+        }
+    }
+
+    const char *p = (const char*)registros;
+    size_t restante = qtd * sizeof(RegistroEvento);
+    while (restante > 0) {
+        ssize_t n = write(fd_eventos, p, restante);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        p += n;
+        restante -= (size_t)n;
+    }
+}
+
+static void gravar_perdidos(int anel, unsigned int perdidos) {
+    RegistroEvento r;
+    memset(&r, 0, sizeof(r));
+    struct timespec agora;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    r.instante_ns = (uint64_t)agora.tv_sec * 1000000000u + (uint64_t)agora.tv_nsec;
+    r.modulo = -1;
+    r.valor = (int32_t)perdidos;
+    r.tipo = EVENTO_PERDIDOS;
+    r.anel = (uint8_t)anel;
+    r.tedax = -1;
+    r.bancada = -1;
+    gravar_registros(&r, 1);
+}
+
+// Copia o conteúdo de cada anel para o arquivo (só a thread de registro, ou parar_eventos)
+static void esvaziar_aneis(void) {
+    for (int i = 0; i < MAX_ANEIS_EVENTOS; i++) {
+        AnelEventos *a = &aneis[i];
+        // Estado lido antes da cabeça: um anel abandonado já tem todos os registros visíveis
+        int estado = atomic_load_explicit(&a->estado, memory_order_acquire);
+        if (estado == ANEL_LIVRE) {
+            continue;
+        }
+        unsigned int cauda = atomic_load_explicit(&a->cauda, memory_order_relaxed);
+        unsigned int cabeca = atomic_load_explicit(&a->cabeca, memory_order_acquire);
+        unsigned int qtd = cabeca - cauda;
+        for (unsigned int k = 0; k < qtd; k++) {
+            lote[k] = a->registros[(cauda + k) & MASCARA_ANEL];
+        }
+        atomic_store_explicit(&a->cauda, cabeca, memory_order_release);
+        gravar_registros(lote, qtd);
+
+        unsigned int perdidos = atomic_exchange_explicit(&a->perdidos, 0, memory_order_relaxed);
+        if (perdidos > 0) {
+            gravar_perdidos(i, perdidos);
+        }
+        if (estado == ANEL_ABANDONADO) {
+            atomic_store_explicit(&a->estado, ANEL_LIVRE, memory_order_release);
+        }
+    }
+    unsigned int sem_anel = atomic_exchange_explicit(&perdidos_sem_anel, 0, memory_order_relaxed);
+    if (sem_anel > 0) {
+        gravar_perdidos(255, sem_anel);
+    }
+}
+
+static void* thread_registro(void* arg) {
+    (void)arg;
+    struct timespec ts;
+    ts.tv_sec = 0;
+    ts.tv_nsec = ESPERA_REGISTRO_NS;
+    while (atomic_load(&registro_ativo)) {
+        esvaziar_aneis();
+        nanosleep(&ts, NULL);
+    }
+    return NULL;
+}
+
+void iniciar_eventos(void) {
+    const char *env = getenv("TEDAX_EVENTOS");
+    if (env && strcmp(env, "0") == 0) {
+        return;
+    }
+    snprintf(caminho_eventos, sizeof(caminho_eventos), "%s", (env && *env) ? env : ARQUIVO_EVENTOS);
+    pthread_once(&chave_criada, criar_chave_anel);
+
+    atomic_store(&registro_ativo, 1);
+    if (pthread_create(&thread_registro_id, NULL, thread_registro, NULL) != 0) {
+        atomic_store(&registro_ativo, 0);
+    }
+}
+
+void parar_eventos(void) {
+    if (!atomic_load(&registro_ativo)) {
+        return;
+    }
+    atomic_store(&registro_ativo, 0);
+    pthread_join(thread_registro_id, NULL);
+    esvaziar_aneis();
+    if (fd_eventos >= 0) {
+        close(fd_eventos);
+    }
+    fd_eventos = -1;
+}
+
+static const char* nome_evento(int tipo) {
+    switch (tipo) {
+        case EVENTO_PARTIDA_INICIO:    return "PARTIDA_INICIO";
+        case EVENTO_PARTIDA_FIM:       return "PARTIDA_FIM";
+        case EVENTO_COMANDO_ACEITO:    return "COMANDO_ACEITO";
+        case EVENTO_COMANDO_REJEITADO: return "COMANDO_REJEITADO";
+        case EVENTO_MODULO_ESTADO:     return "MODULO_ESTADO";
+        case EVENTO_BANCADA_OCUPADA:   return "BANCADA_OCUPADA";
+        case EVENTO_BANCADA_LIBERADA:  return "BANCADA_LIBERADA";
+        case EVENTO_ERRO:              return "ERRO";
+        case EVENTO_PERDIDOS:          return "PERDIDOS";
+        default:                       return "DESCONHECIDO";
+    }
+}
+
+int imprimir_eventos(const char *caminho) {
+    FILE *f = fopen(caminho, "rb");
+    if (!f) {
+        fprintf(stderr, "Erro: nao foi possivel abrir %s\n", caminho);
+        return 1;
+    }
+    CabecalhoEventos c;
+    if (fread(&c, sizeof(c), 1, f) != 1 || memcmp(c.magica, MAGICA_EVENTOS, sizeof(c.magica)) != 0 ||
+        c.versao != VERSAO_EVENTOS || c.tamanho_registro != sizeof(RegistroEvento)) {
+        fprintf(stderr, "Erro: %s nao e um log de eventos versao %d\n", caminho, VERSAO_EVENTOS);
+        fclose(f);
+        return 1;
+    }
+
+    // Instantes relativos ao primeiro registro do arquivo; cada thread grava em ordem,
+    // mas threads diferentes chegam intercaladas em lotes (ordenar pela 1a coluna)
+    RegistroEvento r;
+    uint64_t inicio = 0;
+    long long qtd = 0;
+    while (fread(&r, sizeof(r), 1, f) == 1) {
+        if (qtd++ == 0) {
+            inicio = r.instante_ns;
+        }
+        char texto[sizeof(r.texto) + 1];
+        memcpy(texto, r.texto, sizeof(r.texto));
+        texto[sizeof(r.texto)] = '\0';
+
+        printf("%12.6f anel=%-3d partida=%08x %-17s", (double)(int64_t)(r.instante_ns - inicio) / 1e9,
+               r.anel, r.partida, nome_evento(r.tipo));
+        switch (r.tipo) {
+            case EVENTO_PARTIDA_INICIO:
+                printf(" dificuldade=%s", nome_dificuldade((Dificuldade)r.valor));
+                break;
+            case EVENTO_PARTIDA_FIM:
+                printf(" vitoria=%d", r.valor);
+                break;
+            case EVENTO_COMANDO_ACEITO:
+            case EVENTO_COMANDO_REJEITADO:
+                printf(" comando=\"%s\"", texto);
+                break;
+            case EVENTO_MODULO_ESTADO:
+                printf(" modulo=%d estado=%s", r.modulo, nome_estado_modulo((EstadoModulo)r.valor));
+                break;
+            case EVENTO_BANCADA_OCUPADA:
+                printf(" bancada=%d tedax=%d", r.bancada, r.tedax);
+                break;
+            case EVENTO_BANCADA_LIBERADA:
+                printf(" bancada=%d", r.bancada);
+                break;
+            case EVENTO_ERRO:
+                printf(" modulo=%d tedax=%d erros=%d", r.modulo, r.tedax, r.valor);
+                break;
+            case EVENTO_PERDIDOS:
+                printf(" qtd=%d", r.valor);
+                break;
+        }
+        printf("\n");
+    }
+    fclose(f);
+    return 0;
+}
@@ -0,0 +1,55 @@
+#ifndef EVENTOS_H
+#define EVENTOS_H
+
+#include <stdint.h>
+
+// Registro binário dos eventos da partida para análise posterior. Cada thread escreve
+// em seu próprio anel (produtor único, sem trava); a thread de registro esvazia os anéis
+// e acrescenta os registros, de tamanho fixo, no fim de eventos.bin. Anel cheio descarta
+// o evento e conta a perda, sem nunca bloquear quem joga. TEDAX_EVENTOS=<arquivo> troca o
+// arquivo; TEDAX_EVENTOS=0 desliga. `./jogo --eventos [arquivo]` imprime o log.
+
+#define ARQUIVO_EVENTOS "eventos.bin"
+#define VERSAO_EVENTOS 1
+#define MAX_ANEIS_EVENTOS 32            // Threads registrando ao mesmo tempo
+#define CAPACIDADE_ANEL_EVENTOS 256     // Potência de 2; a thread de registro esvazia a cada 50 ms
+
+typedef enum {
+    EVENTO_PARTIDA_INICIO = 1,          // valor = dificuldade
+    EVENTO_PARTIDA_FIM,                 // valor = 1 vitória, 0 derrota/saída
+    EVENTO_COMANDO_ACEITO,              // texto = comando
+    EVENTO_COMANDO_REJEITADO,           // texto = comando
+    EVENTO_MODULO_ESTADO,               // modulo, valor = novo EstadoModulo
+    EVENTO_BANCADA_OCUPADA,             // bancada, tedax
+    EVENTO_BANCADA_LIBERADA,            // bancada
+    EVENTO_ERRO,                        // modulo, tedax, valor = erros na partida
+    EVENTO_PERDIDOS                     // valor = eventos descartados (anel cheio ou sem anel)
+} TipoEvento;
+
+// Registro de 64 bytes, gravado como está na memória: o cabeçalho do arquivo guarda versão e
+// tamanho, e um leitor em máquina de outra ordem de bytes recusa o arquivo
+typedef struct {
+    uint64_t instante_ns;       // CLOCK_MONOTONIC
+    uint32_t partida;           // Semente da partida
+    int32_t modulo;             // Id do módulo (-1 = nenhum)
+    int32_t valor;
+    uint8_t tipo;               // TipoEvento
+    uint8_t anel;               // Anel (thread) que registrou
+    int8_t tedax;               // Id do tedax (-1 = nenhum)
+    int8_t bancada;             // Id da bancada (-1 = nenhuma)
+    char texto[40];             // Sem '\0' quando ocupa os 40 bytes
+} RegistroEvento;
+
+// Liga o registro (inicia a thread de registro); o arquivo só é criado no primeiro evento
+void iniciar_eventos(void);
+// Esvazia os anéis, fecha o arquivo e encerra a thread
+void parar_eventos(void);
+
+// Chamável de qualquer thread, com ou sem travas; não bloqueia
+void registrar_evento(TipoEvento tipo, uint32_t partida, int tedax, int bancada, int modulo,
+                      int valor, const char *texto);
+
+// --eventos: imprime o arquivo em texto; retorna 0 se leu tudo
+int imprimir_eventos(const char *caminho);
+
+#endif // EVENTOS_H
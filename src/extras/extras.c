@@ -0,0 +1,484 @@
+#define _POSIX_C_SOURCE 200809L
+#include "extras.h"
+#include "../ui/ui.h"
+#include "../fases/fases.h"
+#include "../pool/pool.h"
+#include "../comum/comum.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <ncurses.h>
+
+extern char buffer_instrucao_global[64];
+
+typedef struct PartidaExtras PartidaExtras;
+
+// Exibição e coordenador: criadas uma vez, rodam `corpo` a cada partida e voltam a estacionar
+typedef struct {
+    void (*corpo)(PartidaExtras *e);
+    pthread_t thread;
+} ThreadExtras;
+
+#define QTD_THREADS_EXTRAS 2
+
+// Ordem das travas: mutex_tela antes do mutex_jogo de qualquer bomba, e nunca duas bombas
+// ao mesmo tempo. As tarefas do pool só tomam o mutex_jogo da própria bomba
+struct PartidaExtras {
+    GameState bombas[MAX_BOMBAS];   // Travas criadas uma vez; cada partida só reinicia
+    int qtd;
+    int atual;                      // Bomba na tela (mutex_tela)
+    pthread_mutex_t mutex_tela;     // getch, buffer de comando e desenho
+    PoolThreads *pool;
+
+    // A partida do modo acaba quando as bombas acabam, não quando uma delas acaba
+    atomic_int rodando;
+    pthread_mutex_t mutex_despertar;
+    pthread_cond_t cond_despertar;
+
+    // Estacionamento entre partidas, como em src/ciclo
+    ThreadExtras threads[QTD_THREADS_EXTRAS];
+    int qtd_threads;
+    pthread_mutex_t mutex_ciclo;
+    pthread_cond_t cond_soltar;
+    pthread_cond_t cond_estacionadas;
+    unsigned int geracao;
+    int na_partida;
+    int encerrar;
+    int iniciado;
+};
+
+// Oito GameState: fora da pilha
+static PartidaExtras extras;
+
+static int qtd_bombas_configurada(void) {
+    const char *valor = getenv("TEDAX_BOMBAS");
+    int qtd = valor ? atoi(valor) : BOMBAS_PADRAO;
+    if (qtd < 1) qtd = 1;
+    if (qtd > MAX_BOMBAS) qtd = MAX_BOMBAS;
+    return qtd;
+}
+
+// Com o mutex_jogo da bomba
+static EstadoBomba estado_bomba(const GameState *g) {
+    if (!g->jogo_terminou) {
+        return BOMBA_ATIVA;
+    }
+    return (todos_modulos_resolvidos(g) && g->qtd_modulos > 0) ? BOMBA_DESARMADA : BOMBA_EXPLODIU;
+}
+
+static void encerrar_extras(PartidaExtras *e) {
+    atomic_store(&e->rodando, 0);
+    pthread_mutex_lock(&e->mutex_despertar);
+    pthread_cond_broadcast(&e->cond_despertar);
+    pthread_mutex_unlock(&e->mutex_despertar);
+}
+
+// Como dormir_partida, mas interrompida pelo fim do modo. Retorna 1 se ele segue
+static int dormir_extras(PartidaExtras *e, long nanos) {
+    struct timespec prazo;
+    clock_gettime(CLOCK_MONOTONIC, &prazo);
+    prazo.tv_sec += nanos / 1000000000L;
+    prazo.tv_nsec += nanos % 1000000000L;
+    if (prazo.tv_nsec >= 1000000000L) {
+        prazo.tv_sec++;
+        prazo.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&e->mutex_despertar);
+    while (atomic_load(&e->rodando)) {
+        if (pthread_cond_timedwait(&e->cond_despertar, &e->mutex_despertar, &prazo) == ETIMEDOUT) {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&e->mutex_despertar);
+    return atomic_load(&e->rodando);
+}
+
+// Tarefa do pool: um tick de uma bomba (bomba já encerrada retorna na hora)
+static void tarefa_tick_bomba(void *arg) {
+    GameState *g = (GameState*)arg;
+    pthread_mutex_lock(&g->mutex_jogo);
+    avancar_tick_partida(g);
+    pthread_mutex_unlock(&g->mutex_jogo);
+}
+
+static void exibicao_extras(PartidaExtras *e) {
+    ResumoBomba resumos[MAX_BOMBAS];
+
+    while (atomic_load(&e->rodando)) {
+        pthread_mutex_lock(&e->mutex_tela);
+        for (int i = 0; i < e->qtd; i++) {
+            GameState *b = &e->bombas[i];
+            pthread_mutex_lock(&b->mutex_jogo);
+            resumos[i].tempo_restante = b->tempo_restante;
+            resumos[i].resolvidos = contar_modulos_resolvidos(b);
+            resumos[i].necessarios = b->modulos_necessarios;
+            resumos[i].erros = b->erros_cometidos;
+            resumos[i].estado = estado_bomba(b);
+            pthread_mutex_unlock(&b->mutex_jogo);
+        }
+
+        GameState *g = &e->bombas[e->atual];
+        pthread_mutex_lock(&g->mutex_jogo);
+        desenhar_tela_bombas(g, buffer_instrucao_global, resumos, e->qtd, e->atual);
+        pthread_mutex_unlock(&g->mutex_jogo);
+        pthread_mutex_unlock(&e->mutex_tela);
+
+        dormir_extras(e, 100000000L);
+    }
+}
+
+static void coordenador_extras(PartidaExtras *e) {
+    int buffer_len = 0;
+
+    while (atomic_load(&e->rodando)) {
+        pthread_mutex_lock(&e->mutex_tela);
+        int ch = getch();
+
+        if (ch == 'q' || ch == 'Q') {
+            pthread_mutex_unlock(&e->mutex_tela);
+            encerrar_extras(e);
+            break;
+        } else if (ch == '\t' || ch == KEY_BTAB) {
+            // Outra bomba: o comando em digitação continua no buffer
+            e->atual = (e->atual + (ch == '\t' ? 1 : e->qtd - 1)) % e->qtd;
+        } else if (ch == KEY_RESIZE) {
+            redimensionar_tela_partida();
+        } else if (ch == KEY_UP || ch == KEY_DOWN) {
+            rolar_mural(ch == KEY_UP ? -1 : 1, 0);
+        } else if (ch == KEY_PPAGE || ch == KEY_NPAGE) {
+            rolar_mural(0, ch == KEY_PPAGE ? -1 : 1);
+        } else if (ch == KEY_BACKSPACE || ch == 127 || ch == '\b') {
+            if (buffer_len > 0) {
+                buffer_len--;
+                buffer_instrucao_global[buffer_len] = '\0';
+            }
+        } else if (ch == '\n' || ch == '\r') {
+            GameState *g = &e->bombas[e->atual];
+            pthread_mutex_lock(&g->mutex_jogo);
+            executar_comando(g, buffer_instrucao_global);
+            pthread_mutex_unlock(&g->mutex_jogo);
+            buffer_len = 0;
+            buffer_instrucao_global[0] = '\0';
+        } else if (ch >= 32 && ch <= 126) {
+            if (buffer_len < 63) {
+                buffer_instrucao_global[buffer_len] = (char)ch;
+                buffer_len++;
+                buffer_instrucao_global[buffer_len] = '\0';
+            }
+        }
+        pthread_mutex_unlock(&e->mutex_tela);
+
+        dormir_extras(e, 50000000L);
+    }
+}
+
+static void* thread_extras(void *arg) {
+    ThreadExtras *t = (ThreadExtras*)arg;
+    unsigned int vista = 0;
+
+    pthread_mutex_lock(&extras.mutex_ciclo);
+    while (1) {
+        while (!extras.encerrar && extras.geracao == vista) {
+            pthread_cond_wait(&extras.cond_soltar, &extras.mutex_ciclo);
+        }
+        if (extras.encerrar) {
+            break;
+        }
+        vista = extras.geracao;
+        pthread_mutex_unlock(&extras.mutex_ciclo);
+
+        t->corpo(&extras);
+
+        pthread_mutex_lock(&extras.mutex_ciclo);
+        if (--extras.na_partida == 0) {
+            pthread_cond_signal(&extras.cond_estacionadas);
+        }
+    }
+    pthread_mutex_unlock(&extras.mutex_ciclo);
+    return NULL;
+}
+
+// Acorda as threads estacionadas para encerrar e espera as `qtd_threads` criadas
+static void juntar_threads_extras(PartidaExtras *e) {
+    pthread_mutex_lock(&e->mutex_ciclo);
+    e->encerrar = 1;
+    pthread_cond_broadcast(&e->cond_soltar);
+    pthread_mutex_unlock(&e->mutex_ciclo);
+    for (int i = 0; i < e->qtd_threads; i++) {
+        pthread_join(e->threads[i].thread, NULL);
+    }
+    e->qtd_threads = 0;
+}
+
+static void destruir_recursos_extras(PartidaExtras *e) {
+    pool_destruir(e->pool);
+    e->pool = NULL;
+    for (int i = 0; i < MAX_BOMBAS; i++) {
+        destruir_sincronizacao_jogo(&e->bombas[i]);
+    }
+    pthread_mutex_destroy(&e->mutex_tela);
+    pthread_mutex_destroy(&e->mutex_despertar);
+    pthread_cond_destroy(&e->cond_despertar);
+    pthread_mutex_destroy(&e->mutex_ciclo);
+    pthread_cond_destroy(&e->cond_soltar);
+    pthread_cond_destroy(&e->cond_estacionadas);
+}
+
+// Na primeira partida do modo: pool, travas das bombas e threads estacionadas.
+// Retorna 0 (nada fica criado) se o pool ou uma das threads não sobe
+static int iniciar_extras(PartidaExtras *e) {
+    if (e->iniciado) {
+        return 1;
+    }
+    e->pool = pool_criar(0);
+    if (!e->pool) {
+        return 0;
+    }
+
+    for (int i = 0; i < MAX_BOMBAS; i++) {
+        criar_sincronizacao_jogo(&e->bombas[i]);
+        e->bombas[i].jogo_rodando = 0;
+    }
+    pthread_mutex_init(&e->mutex_tela, NULL);
+    pthread_condattr_t attr_cond;
+    pthread_condattr_init(&attr_cond);
+    pthread_condattr_setclock(&attr_cond, CLOCK_MONOTONIC);
+    pthread_mutex_init(&e->mutex_despertar, NULL);
+    pthread_cond_init(&e->cond_despertar, &attr_cond);
+    pthread_condattr_destroy(&attr_cond);
+    pthread_mutex_init(&e->mutex_ciclo, NULL);
+    pthread_cond_init(&e->cond_soltar, NULL);
+    pthread_cond_init(&e->cond_estacionadas, NULL);
+    e->geracao = 0;
+    e->na_partida = 0;
+    e->encerrar = 0;
+
+    void (*corpos[QTD_THREADS_EXTRAS])(PartidaExtras*) = { exibicao_extras, coordenador_extras };
+    e->qtd_threads = 0;
+    for (int i = 0; i < QTD_THREADS_EXTRAS; i++) {
+        e->threads[i].corpo = corpos[i];
+        if (pthread_create(&e->threads[i].thread, NULL, thread_extras, &e->threads[i]) != 0) {
+            juntar_threads_extras(e);
+            destruir_recursos_extras(e);
+            return 0;
+        }
+        e->qtd_threads++;
+    }
+    e->iniciado = 1;
+    return 1;
+}
+
+// Com as threads estacionadas (fora de partida)
+void extras_encerrar(void) {
+    PartidaExtras *e = &extras;
+    if (!e->iniciado) {
+        return;
+    }
+    juntar_threads_extras(e);
+    destruir_recursos_extras(e);
+    e->iniciado = 0;
+}
+
+void jogar_extras(Dificuldade dificuldade, ResultadoExtras *resultado) {
+    PartidaExtras *e = &extras;
+    ConfigFase config = obter_config_fase(dificuldade);
+
+    // Sem pool ou threads não há partida: volta ao menu como não iniciada (modulos_gerados = 0)
+    memset(resultado, 0, sizeof(*resultado));
+    if (!iniciar_extras(e)) {
+        return;
+    }
+
+    e->qtd = qtd_bombas_configurada();
+    e->atual = 0;
+    atomic_store(&e->rodando, 1);
+
+    // Sem threads por bomba (threads_da_partida = 0): mural e tedax andam no tick
+    for (int i = 0; i < e->qtd; i++) {
+        reiniciar_jogo(&e->bombas[i], dificuldade, config.num_tedax, config.num_bancadas);
+    }
+    buffer_instrucao_global[0] = '\0';
+
+    iniciar_tela_partida();
+    definir_entrada_bloqueante(0);
+
+    pthread_mutex_lock(&e->mutex_ciclo);
+    e->na_partida = e->qtd_threads;
+    e->geracao++;
+    pthread_cond_broadcast(&e->cond_soltar);
+    pthread_mutex_unlock(&e->mutex_ciclo);
+
+    // Thread principal: a cada tick de 0.2s, um tick de cada bomba como tarefa do pool.
+    // Uma bomba que explode leva as outras junto; todas desarmadas é vitória
+    while (dormir_extras(e, 200000000L)) {
+        for (int i = 0; i < e->qtd; i++) {
+            pool_enviar(e->pool, tarefa_tick_bomba, &e->bombas[i]);
+        }
+        pool_esperar(e->pool);
+
+        int ativas = 0;
+        int explodiu = 0;
+        for (int i = 0; i < e->qtd; i++) {
+            GameState *b = &e->bombas[i];
+            pthread_mutex_lock(&b->mutex_jogo);
+            EstadoBomba estado = estado_bomba(b);
+            pthread_mutex_unlock(&b->mutex_jogo);
+            ativas += estado == BOMBA_ATIVA;
+            explodiu |= estado == BOMBA_EXPLODIU;
+        }
+        if (explodiu || ativas == 0) {
+            encerrar_extras(e);
+        }
+    }
+
+    // Saída do jogador ou explosão: as bombas ainda ativas param onde estão
+    for (int i = 0; i < e->qtd; i++) {
+        GameState *b = &e->bombas[i];
+        pthread_mutex_lock(&b->mutex_jogo);
+        encerrar_partida(b, 0);
+        pthread_mutex_unlock(&b->mutex_jogo);
+    }
+    pthread_mutex_lock(&e->mutex_ciclo);
+    while (e->na_partida > 0) {
+        pthread_cond_wait(&e->cond_estacionadas, &e->mutex_ciclo);
+    }
+    pthread_mutex_unlock(&e->mutex_ciclo);
+
+    encerrar_tela_partida();
+    definir_entrada_bloqueante(1);
+    erase();
+    refresh();
+
+    // Threads já estacionadas: o resultado é lido sem as travas
+    resultado->bombas = e->qtd;
+    resultado->tempo_restante = e->bombas[0].tempo_restante;
+    for (int i = 0; i < e->qtd; i++) {
+        GameState *b = &e->bombas[i];
+        resultado->desarmadas += estado_bomba(b) == BOMBA_DESARMADA;
+        resultado->erros += b->erros_cometidos;
+        resultado->modulos_gerados += b->qtd_modulos;
+        if (b->tempo_restante < resultado->tempo_restante) {
+            resultado->tempo_restante = b->tempo_restante;
+        }
+        terminar_jogo(b);
+    }
+    resultado->vitoria = resultado->desarmadas == e->qtd;
+}
+
+// --- Bench: partidas inteiras como tarefas ---
+
+typedef struct {
+    GameState g;
+    long long ticks;
+} BombaSimulada;
+
+// Robô do bench: cada tedax livre pega o primeiro módulo pendente sem dono, com a resposta certa
+static void robo_jogar(GameState *g) {
+    for (int t = 0; t < g->qtd_tedax && g->pendentes_livres > 0; t++) {
+        if (g->tedax[t].estado != TEDAX_LIVRE) {
+            continue;
+        }
+        for (int m = 0; m < g->qtd_modulos; m++) {
+            if (g->quente.estado[m] == MOD_PENDENTE && !g->quente.reservado[m]) {
+                char comando[64];
+                snprintf(comando, sizeof(comando), "T%dM%d:%s", g->tedax[t].id, g->quente.id[m],
+                         g->modulos[m].instrucao_correta);
+                executar_comando(g, comando);
+                break;
+            }
+        }
+    }
+}
+
+// Tarefa do pool: uma bomba do primeiro ao último tick, sem pausas
+static void tarefa_simular_bomba(void *arg) {
+    BombaSimulada *b = (BombaSimulada*)arg;
+    int terminou = 0;
+    while (!terminou) {
+        pthread_mutex_lock(&b->g.mutex_jogo);
+        robo_jogar(&b->g);
+        terminou = avancar_tick_partida(&b->g);
+        pthread_mutex_unlock(&b->g.mutex_jogo);
+        b->ticks++;
+    }
+}
+
+int executar_bench_bombas(int qtd_bombas, int num_threads) {
+    if (qtd_bombas < 1) {
+        qtd_bombas = BOMBAS_BENCH_PADRAO;
+    }
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int max_threads = num_threads > 0 ? num_threads : (cpus > 0 ? (int)cpus : 1);
+    if (max_threads > MAX_WORKERS_POOL) {
+        max_threads = MAX_WORKERS_POOL;
+    }
+
+    BombaSimulada *bombas = calloc((size_t)qtd_bombas, sizeof(BombaSimulada));
+    if (!bombas) {
+        fprintf(stderr, "Erro: sem memoria para %d bombas\n", qtd_bombas);
+        return 1;
+    }
+    printf("Bench: %d partidas (%s) por rodada, %ld nucleo(s) online\n",
+           qtd_bombas, nome_dificuldade(DIFICULDADE_FACIL), cpus);
+    // Travas criadas uma vez; cada rodada só reinicia as partidas
+    for (int i = 0; i < qtd_bombas; i++) {
+        criar_sincronizacao_jogo(&bombas[i].g);
+    }
+
+    // 1, 2, 4... e por último max_threads
+    for (int threads = 1; ; threads *= 2) {
+        if (threads > max_threads) {
+            threads = max_threads;
+        }
+        for (int i = 0; i < qtd_bombas; i++) {
+            reiniciar_jogo(&bombas[i].g, DIFICULDADE_FACIL, 0, 0);
+            bombas[i].ticks = 0;
+        }
+        PoolThreads *pool = pool_criar(threads);
+        if (!pool) {
+            fprintf(stderr, "Erro: nao foi possivel criar o pool com %d thread(s)\n", threads);
+            for (int i = 0; i < qtd_bombas; i++) {
+                finalizar_jogo(&bombas[i].g);
+            }
+            free(bombas);
+            return 1;
+        }
+
+        struct timespec inicio, fim;
+        clock_gettime(CLOCK_MONOTONIC, &inicio);
+        for (int i = 0; i < qtd_bombas; i++) {
+            pool_enviar(pool, tarefa_simular_bomba, &bombas[i]);
+        }
+        pool_esperar(pool);
+        clock_gettime(CLOCK_MONOTONIC, &fim);
+        double segundos = ms_entre(&inicio, &fim) / 1000.0;
+
+        long long executadas, roubadas, ticks = 0;
+        int vitorias = 0;
+        pool_estatisticas(pool, &executadas, &roubadas);
+        pool_destruir(pool);
+        for (int i = 0; i < qtd_bombas; i++) {
+            ticks += bombas[i].ticks;
+            vitorias += todos_modulos_resolvidos(&bombas[i].g) && bombas[i].g.qtd_modulos > 0;
+            terminar_jogo(&bombas[i].g);
+        }
+
+        printf("%2d thread(s): %8.0f partidas/s %10.0f ticks/s  %.3f s  (%d vitorias, %lld roubos)\n",
+               threads, qtd_bombas / segundos, ticks / segundos, segundos, vitorias, roubadas);
+        if (threads == max_threads) {
+            break;
+        }
+    }
+
+    for (int i = 0; i < qtd_bombas; i++) {
+        destruir_sincronizacao_jogo(&bombas[i].g);
+    }
+    free(bombas);
+    return 0;
+}
@@ -0,0 +1,37 @@
+#ifndef EXTRAS_H
+#define EXTRAS_H
+
+#include "../game/game.h"
+
+// Modo Extras: várias bombas independentes na mesma partida, cada uma um GameState com
+// mural, tedax, bancadas e relógio próprios. Nenhuma bomba tem threads: como no servidor,
+// o trabalho de mural e tedax roda no tick (threads_da_partida = 0), e os ticks de todas
+// as bombas são tarefas de um pool com roubo de trabalho (src/pool), uma thread por núcleo.
+// O jogador troca de bomba com TAB; a partida acaba quando todas forem desarmadas ou
+// quando alguma explodir. TEDAX_BOMBAS=<1..8> muda a quantidade de bombas.
+// Como em src/ciclo, pool, travas das bombas e as threads de exibição e coordenador são
+// criados na primeira partida do modo e ficam estacionados entre uma partida e outra.
+
+#define MAX_BOMBAS 8
+#define BOMBAS_PADRAO 3
+#define BOMBAS_BENCH_PADRAO 256
+
+typedef struct {
+    int vitoria;                // Todas as bombas desarmadas
+    int tempo_restante;         // Menor tempo restante entre as bombas
+    int erros;                  // Soma dos erros de todas as bombas
+    int bombas;
+    int desarmadas;
+    int modulos_gerados;        // 0 = nenhuma bomba chegou a gerar módulo
+} ResultadoExtras;
+
+// Roda o modo na sessão ncurses já aberta; as threads são soltas e estacionadas aqui
+void jogar_extras(Dificuldade dificuldade, ResultadoExtras *resultado);
+// Encerra threads e pool e destrói as travas (ao sair do jogo, fora de partida)
+void extras_encerrar(void);
+
+// --bombas: simula `qtd_bombas` partidas fáceis completas, sem tela, resolvidas por um robô,
+// e imprime a vazão do pool com 1, 2, 4... threads até `num_threads` (< 1 = núcleos online)
+int executar_bench_bombas(int qtd_bombas, int num_threads);
+
+#endif // EXTRAS_H
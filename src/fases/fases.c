@@ -1,8 +1,23 @@
+#define _DEFAULT_SOURCE
 #include "fases.h"
 #include "../game/game.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <ctype.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <poll.h>
+#include <sys/inotify.h>
 
-// Config por dificuldade
-static const ConfigFase config_fases[] = {
+#define QTD_FASES 4
+#define TAMANHO_ERRO 128
+
+// Config por dificuldade (valores padrão, usados quando não há fases.cfg)
+static const ConfigFase config_padrao[QTD_FASES] = {
     // FACIL
     {
         .num_tedax = 2,
@@ -12,9 +27,11 @@ static const ConfigFase config_fases[] = {
         .modulos_iniciais = 2,
         .tempo_total_partida = 120,      // em Segundos
         .tempo_minimo_execucao = 3,     // 3 segundos mínimo
-        .tempo_variacao_execucao = 8    // Variação de 0 a 8 segundos
+        .tempo_variacao_execucao = 8,   // Variação de 0 a 8 segundos
+        .profundidade_fila = 2,         // 2 módulos em espera por tedax
+        .dificuldade_modulos = DIFICULDADE_FACIL
     },
-    
+
     // MEDIO
     {
         .num_tedax = 3,
@@ -24,9 +41,11 @@ static const ConfigFase config_fases[] = {
         .modulos_iniciais = 3,
         .tempo_total_partida = 180,     // em Segundos
         .tempo_minimo_execucao = 5,     // 5 segundos mínimo (+2 do fácil)
-        .tempo_variacao_execucao = 15   // Variação de 0 a 15 segundos (50% mais que fácil)
+        .tempo_variacao_execucao = 15,  // Variação de 0 a 15 segundos (50% mais que fácil)
+        .profundidade_fila = 3,         // 3 módulos em espera por tedax
+        .dificuldade_modulos = DIFICULDADE_MEDIO
     },
-    
+
     // DIFICIL
     {
         .num_tedax = 4,
@@ -36,29 +55,341 @@ static const ConfigFase config_fases[] = {
         .modulos_iniciais = 5,
         .tempo_total_partida = 210,     // em Segundos
         .tempo_minimo_execucao = 9,     // 9 segundos mínimo (+4 do fácil)
-        .tempo_variacao_execucao = 20   // Variação de 0 a 20 segundos (100% mais que fácil)
+        .tempo_variacao_execucao = 20,  // Variação de 0 a 20 segundos (100% mais que fácil)
+        .profundidade_fila = 4,         // 4 módulos em espera por tedax
+        .dificuldade_modulos = DIFICULDADE_DIFICIL
+    },
+
+    // CUSTOM (só fica disponível se fases.cfg tiver a seção [custom])
+    {
+        .num_tedax = 3,
+        .num_bancadas = 2,
+        .modulos_necessarios = 10,
+        .intervalo_geracao = 100,
+        .modulos_iniciais = 3,
+        .tempo_total_partida = 180,
+        .tempo_minimo_execucao = 5,
+        .tempo_variacao_execucao = 15,
+        .profundidade_fila = 3,
+        .dificuldade_modulos = DIFICULDADE_MEDIO
     }
 };
 
-// Get baseado na dificuldade
-const ConfigFase* obter_config_fase(Dificuldade dificuldade) {
-    int index = 0;
-    
+// Configuração em vigor e erro da última carga: lidos e trocados só sob mutex_config
+static ConfigFase config_fases[QTD_FASES];
+static char ultimo_erro[TAMANHO_ERRO] = "";
+static pthread_mutex_t mutex_config = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t config_iniciada = PTHREAD_ONCE_INIT;
+static atomic_int custom_disponivel = 0;
+
+// Serializa recargas (a leitura do arquivo acontece fora de mutex_config)
+static pthread_mutex_t mutex_carga = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_t thread_monitor_id;
+static int monitor_rodando = 0;
+static int monitor_pipe[2] = {-1, -1};
+static char caminho_monitorado[256];
+
+// Limites aceitos para cada campo do arquivo
+typedef struct {
+    const char *nome;
+    size_t offset;
+    int minimo;
+    int maximo;
+} CampoConfig;
+
+static const CampoConfig campos[] = {
+    { "num_tedax",               offsetof(ConfigFase, num_tedax),               1, MAX_TEDAX },
+    { "num_bancadas",            offsetof(ConfigFase, num_bancadas),            1, MAX_BANCADAS },
+    { "modulos_necessarios",     offsetof(ConfigFase, modulos_necessarios),     1, 100 },
+    { "intervalo_geracao",       offsetof(ConfigFase, intervalo_geracao),       1, 3000 },
+    { "modulos_iniciais",        offsetof(ConfigFase, modulos_iniciais),        0, 100 },
+    { "tempo_total_partida",     offsetof(ConfigFase, tempo_total_partida),     10, 3600 },
+    { "tempo_minimo_execucao",   offsetof(ConfigFase, tempo_minimo_execucao),   1, 120 },
+    { "tempo_variacao_execucao", offsetof(ConfigFase, tempo_variacao_execucao), 0, 120 },
+    { "profundidade_fila",       offsetof(ConfigFase, profundidade_fila),       1, MAX_FILA_TEDAX }
+};
+
+static void copiar_config_padrao(void) {
+    memcpy(config_fases, config_padrao, sizeof(config_padrao));
+}
+
+static int indice_fase(Dificuldade dificuldade) {
     switch (dificuldade) {
         case DIFICULDADE_FACIL:
-            index = 0;
-            break;
+            return 0;
         case DIFICULDADE_MEDIO:
-            index = 1;
-            break;
+            return 1;
         case DIFICULDADE_DIFICIL:
-            index = 2;
-            break;
+            return 2;
+        case DIFICULDADE_CUSTOM:
+            return 3;
         default:
-            index = 0;
+            return 0;
+    }
+}
+
+static int indice_secao(const char *nome) {
+    if (strcmp(nome, "facil") == 0) return 0;
+    if (strcmp(nome, "medio") == 0) return 1;
+    if (strcmp(nome, "dificil") == 0) return 2;
+    if (strcmp(nome, "custom") == 0) return 3;
+    return -1;
+}
+
+static char* aparar(char *s) {
+    while (isspace((unsigned char)*s)) s++;
+    char *fim = s + strlen(s);
+    while (fim > s && isspace((unsigned char)fim[-1])) fim--;
+    *fim = '\0';
+    return s;
+}
+
+static void registrar_erro(char erro[TAMANHO_ERRO], const char *caminho, int linha, const char *motivo) {
+    if (linha > 0) {
+        snprintf(erro, TAMANHO_ERRO, "%s: linha %d: %s", caminho, linha, motivo);
+    } else {
+        snprintf(erro, TAMANHO_ERRO, "%s: %s", caminho, motivo);
+    }
+}
+
+// Lê o arquivo em 'destino'; retorna 1 se válido (senão descreve o problema em 'erro')
+static int interpretar_arquivo(const char *caminho, ConfigFase destino[QTD_FASES], int *tem_custom,
+                               char erro[TAMANHO_ERRO]) {
+    FILE *arquivo = fopen(caminho, "r");
+    if (!arquivo) {
+        registrar_erro(erro, caminho, 0, strerror(errno));
+        return 0;
+    }
+
+    memcpy(destino, config_padrao, sizeof(config_padrao));
+    *tem_custom = 0;
+
+    char linha_buf[256];
+    int num_linha = 0;
+    int secao = -1;
+    int valido = 1;
+
+    while (valido && fgets(linha_buf, sizeof(linha_buf), arquivo)) {
+        num_linha++;
+        char *comentario = strchr(linha_buf, '#');
+        if (comentario) *comentario = '\0';
+        char *linha = aparar(linha_buf);
+        if (*linha == '\0') {
+            continue;
+        }
+
+        if (*linha == '[') {
+            char *fecha = strchr(linha, ']');
+            if (!fecha) {
+                registrar_erro(erro, caminho, num_linha, "secao sem ']'");
+                valido = 0;
+                break;
+            }
+            *fecha = '\0';
+            secao = indice_secao(aparar(linha + 1));
+            if (secao < 0) {
+                registrar_erro(erro, caminho, num_linha, "secao desconhecida");
+                valido = 0;
+            } else if (secao == 3) {
+                *tem_custom = 1;
+            }
+            continue;
+        }
+
+        char *igual = strchr(linha, '=');
+        if (!igual || secao < 0) {
+            registrar_erro(erro, caminho, num_linha, "esperado 'chave = valor' dentro de uma secao");
+            valido = 0;
             break;
+        }
+        *igual = '\0';
+        char *chave = aparar(linha);
+        char *valor = aparar(igual + 1);
+
+        if (strcmp(chave, "base") == 0) {
+            int base = indice_secao(valor);
+            if (base < 0 || base > 2) {
+                registrar_erro(erro, caminho, num_linha, "base deve ser facil, medio ou dificil");
+                valido = 0;
+            } else {
+                destino[secao].dificuldade_modulos = (Dificuldade)base;
+            }
+            continue;
+        }
+
+        const CampoConfig *campo = NULL;
+        for (size_t i = 0; i < sizeof(campos) / sizeof(campos[0]); i++) {
+            if (strcmp(chave, campos[i].nome) == 0) {
+                campo = &campos[i];
+                break;
+            }
+        }
+        if (!campo) {
+            registrar_erro(erro, caminho, num_linha, "chave desconhecida");
+            valido = 0;
+            break;
+        }
+
+        char *fim_num;
+        long numero = strtol(valor, &fim_num, 10);
+        if (*valor == '\0' || *fim_num != '\0' || numero < campo->minimo || numero > campo->maximo) {
+            char motivo[96];
+            snprintf(motivo, sizeof(motivo), "%s fora do limite [%d, %d]",
+                     campo->nome, campo->minimo, campo->maximo);
+            registrar_erro(erro, caminho, num_linha, motivo);
+            valido = 0;
+            break;
+        }
+        *(int*)((char*)&destino[secao] + campo->offset) = (int)numero;
+    }
+    fclose(arquivo);
+
+    // Validação cruzada entre campos
+    for (int i = 0; valido && i < QTD_FASES; i++) {
+        if (destino[i].modulos_iniciais > destino[i].modulos_necessarios) {
+            registrar_erro(erro, caminho, 0, "modulos_iniciais maior que modulos_necessarios");
+            valido = 0;
+        }
+    }
+
+    return valido;
+}
+
+int carregar_config_fases(const char *caminho) {
+    pthread_once(&config_iniciada, copiar_config_padrao);
+    pthread_mutex_lock(&mutex_carga);
+
+    ConfigFase nova[QTD_FASES];
+    char erro[TAMANHO_ERRO] = "";
+    int tem_custom = 0;
+    int ok = interpretar_arquivo(caminho, nova, &tem_custom, erro);
+
+    pthread_mutex_lock(&mutex_config);
+    if (ok) {
+        memcpy(config_fases, nova, sizeof(nova));
+        atomic_store(&custom_disponivel, tem_custom);
+    }
+    memcpy(ultimo_erro, erro, sizeof(ultimo_erro));
+    pthread_mutex_unlock(&mutex_config);
+
+    pthread_mutex_unlock(&mutex_carga);
+    return ok;
+}
+
+int erro_config_fases(char *destino, size_t tamanho) {
+    pthread_mutex_lock(&mutex_config);
+    snprintf(destino, tamanho, "%s", ultimo_erro);
+    pthread_mutex_unlock(&mutex_config);
+    return destino[0] != '\0';
+}
+
+int config_custom_disponivel(void) {
+    return atomic_load(&custom_disponivel);
+}
+
+// Observa o diretório do arquivo (editores costumam substituir o arquivo ao salvar)
+static void* thread_monitor_config(void *arg) {
+    (void)arg;
+
+    char diretorio[256];
+    const char *nome_arquivo = caminho_monitorado;
+    const char *barra = strrchr(caminho_monitorado, '/');
+    if (barra) {
+        size_t tam = (size_t)(barra - caminho_monitorado);
+        if (tam == 0) tam = 1;
+        if (tam >= sizeof(diretorio)) tam = sizeof(diretorio) - 1;
+        memcpy(diretorio, caminho_monitorado, tam);
+        diretorio[tam] = '\0';
+        nome_arquivo = barra + 1;
+    } else {
+        strcpy(diretorio, ".");
+    }
+
+    int fd = inotify_init1(IN_CLOEXEC);
+    if (fd < 0) {
+        return NULL;
     }
-    
-    return &config_fases[index];
+    if (inotify_add_watch(fd, diretorio, IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+        close(fd);
+        return NULL;
+    }
+
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    struct pollfd fds[2] = {
+        { .fd = fd, .events = POLLIN },
+        { .fd = monitor_pipe[0], .events = POLLIN }
+    };
+
+    while (1) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[1].revents) {
+            break;
+        }
+
+        ssize_t lidos = read(fd, buffer, sizeof(buffer));
+        if (lidos <= 0) {
+            continue;
+        }
+
+        int recarregar = 0;
+        for (char *p = buffer; p < buffer + lidos; ) {
+            struct inotify_event *evento = (struct inotify_event*)p;
+            if (evento->len > 0 && strcmp(evento->name, nome_arquivo) == 0) {
+                recarregar = 1;
+            }
+            p += sizeof(struct inotify_event) + evento->len;
+        }
+        if (recarregar) {
+            carregar_config_fases(caminho_monitorado);
+        }
+    }
+
+    close(fd);
+    return NULL;
+}
+
+int iniciar_monitor_config(const char *caminho) {
+    if (monitor_rodando) {
+        return 1;
+    }
+    strncpy(caminho_monitorado, caminho, sizeof(caminho_monitorado) - 1);
+    caminho_monitorado[sizeof(caminho_monitorado) - 1] = '\0';
+
+    if (pipe(monitor_pipe) < 0) {
+        return 0;
+    }
+    if (pthread_create(&thread_monitor_id, NULL, thread_monitor_config, NULL) != 0) {
+        close(monitor_pipe[0]);
+        close(monitor_pipe[1]);
+        return 0;
+    }
+    monitor_rodando = 1;
+    return 1;
 }
 
+void parar_monitor_config(void) {
+    if (!monitor_rodando) {
+        return;
+    }
+    if (write(monitor_pipe[1], "x", 1) < 0) {
+        // Sem como acordar o monitor: ele termina junto com o processo
+        return;
+    }
+    pthread_join(thread_monitor_id, NULL);
+    close(monitor_pipe[0]);
+    close(monitor_pipe[1]);
+    monitor_rodando = 0;
+}
+
+// Get baseado na dificuldade (cópia: uma recarga concorrente não altera o valor devolvido)
+ConfigFase obter_config_fase(Dificuldade dificuldade) {
+    pthread_once(&config_iniciada, copiar_config_padrao);
+    pthread_mutex_lock(&mutex_config);
+    ConfigFase config = config_fases[indice_fase(dificuldade)];
+    pthread_mutex_unlock(&mutex_config);
+    return config;
+}
@@ -2,6 +2,7 @@
 #define FASES_H
 
 #include "../game/game.h"
+#include <stddef.h>
 
 typedef struct {
     int num_tedax;
@@ -12,8 +13,22 @@ typedef struct {
     int tempo_total_partida;
     int tempo_minimo_execucao;
     int tempo_variacao_execucao;
+    int profundidade_fila;      // Módulos que cada tedax aceita em espera
+    Dificuldade dificuldade_modulos; // Tabela de tipos/tamanhos usada na geração de módulos
 } ConfigFase;
 
-const ConfigFase* obter_config_fase(Dificuldade dificuldade);
+#define ARQUIVO_CONFIG_FASES "fases.cfg"
+
+ConfigFase obter_config_fase(Dificuldade dificuldade);
+
+// Carrega/valida o arquivo de fases; mantém a configuração anterior se for inválido
+int carregar_config_fases(const char *caminho);
+// Copia o erro da última carga para 'destino'; retorna 1 se houver erro
+int erro_config_fases(char *destino, size_t tamanho);
+int config_custom_disponivel(void);
+
+// Recarrega o arquivo automaticamente quando ele muda (inotify)
+int iniciar_monitor_config(const char *caminho);
+void parar_monitor_config(void);
 
 #endif
\ No newline at end of file
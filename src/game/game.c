@@ -1,7 +1,17 @@
+#define _POSIX_C_SOURCE 200809L
 #include "game.h"
 #include "../ui/ui.h"
 #include "../fases/fases.h"
 #include "../modulos/modulos.h"
+#include "../bancadas/bancadas.h"
+#include "../escalonamento/escalonamento.h"
+#include "../utilizacao/utilizacao.h"
+#include "../painel/painel.h"
+#include "../salvamento/salvamento.h"
+#include "../latencia/latencia.h"
+#include "../eventos/eventos.h"
+#include "../comum/comum.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -9,22 +19,78 @@
 #include <errno.h>
 #include <ncurses.h>
 
-void inicializar_jogo(GameState *g, Dificuldade dificuldade, int num_tedax, int num_bancadas) {
-    const ConfigFase *config = obter_config_fase(dificuldade);
+_Static_assert(TEMPORIZADOR_RESOLVIDO(MAX_MODULOS) <= MAX_TEMPORIZADORES,
+               "a roda precisa de um id para cada prazo da partida");
+
+static void repor_modulo_se_necessario(GameState *g);
+
+// Travas e condições de um GameState: criadas uma vez, valem para todas as partidas que
+// reiniciar_jogo montar nele (com todas as threads da partida anterior já fora)
+void criar_sincronizacao_jogo(GameState *g) {
+    pthread_mutex_init(&g->mutex_jogo, NULL);
+    pthread_cond_init(&g->cond_modulo_disponivel, NULL);
+    pthread_cond_init(&g->cond_bancada_disponivel, NULL);
+    pthread_cond_init(&g->cond_tela_atualizada, NULL);
+    pthread_cond_init(&g->cond_mural, NULL);
+    for (int i = 0; i < MAX_TEDAX; i++) {
+        pthread_cond_init(&g->tedax[i].cond_trabalho, NULL);
+    }
+    
+    // Pausas com prazo usam relógio monotônico (timedwait)
+    pthread_condattr_t attr_cond;
+    pthread_condattr_init(&attr_cond);
+    pthread_condattr_setclock(&attr_cond, CLOCK_MONOTONIC);
+    pthread_mutex_init(&g->mutex_despertar, NULL);
+    pthread_cond_init(&g->cond_despertar, &attr_cond);
+    pthread_condattr_destroy(&attr_cond);
+    
+    pthread_mutex_init(&g->estoque.mutex, NULL);
+    pthread_cond_init(&g->estoque.cond_espaco, NULL);
+}
+
+void destruir_sincronizacao_jogo(GameState *g) {
+    pthread_mutex_destroy(&g->mutex_jogo);
+    pthread_cond_destroy(&g->cond_modulo_disponivel);
+    pthread_cond_destroy(&g->cond_bancada_disponivel);
+    pthread_cond_destroy(&g->cond_tela_atualizada);
+    pthread_cond_destroy(&g->cond_mural);
+    pthread_mutex_destroy(&g->mutex_despertar);
+    pthread_cond_destroy(&g->cond_despertar);
+    pthread_mutex_destroy(&g->estoque.mutex);
+    pthread_cond_destroy(&g->estoque.cond_espaco);
+    for (int i = 0; i < MAX_TEDAX; i++) {
+        pthread_cond_destroy(&g->tedax[i].cond_trabalho);
+    }
+}
+
+// Partida nova no mesmo GameState, sem alocar nem recriar travas
+void reiniciar_jogo(GameState *g, Dificuldade dificuldade, int num_tedax, int num_bancadas) {
+    // Cada partida tem seu gerador: sessões paralelas não disputam rand() e o estado pode ser salvo
+    struct timespec agora;
+    clock_gettime(CLOCK_REALTIME, &agora);
+    unsigned int semente = (unsigned int)agora.tv_sec ^ (unsigned int)agora.tv_nsec ^ (unsigned int)(size_t)g;
+    reiniciar_jogo_semente(g, dificuldade, num_tedax, num_bancadas, semente);
+}
+
+void reiniciar_jogo_semente(GameState *g, Dificuldade dificuldade, int num_tedax, int num_bancadas,
+                            unsigned int semente) {
+    ConfigFase config = obter_config_fase(dificuldade);
     
-    if (num_tedax < 1) num_tedax = config->num_tedax;
-    if (num_tedax > 5) num_tedax = 5;
-    if (num_bancadas < 1) num_bancadas = config->num_bancadas;
-    if (num_bancadas > 5) num_bancadas = 5;
+    if (num_tedax < 1) num_tedax = config.num_tedax;
+    if (num_tedax > MAX_TEDAX) num_tedax = MAX_TEDAX;
+    if (num_bancadas < 1) num_bancadas = config.num_bancadas;
+    if (num_bancadas > MAX_BANCADAS) num_bancadas = MAX_BANCADAS;
     
     g->dificuldade = dificuldade;
-    g->tempo_total_partida = config->tempo_total_partida;
+    g->tempo_total_partida = config.tempo_total_partida;
     g->tempo_restante = g->tempo_total_partida;
     g->qtd_modulos = 0;
     g->proximo_id_modulo = 1;
-    g->modulos_necessarios = config->modulos_necessarios;
-    g->intervalo_geracao = config->intervalo_geracao;
-    g->max_modulos = config->modulos_necessarios;
+    g->versao_mural = 0;
+    g->pendentes_livres = 0;
+    g->modulos_necessarios = config.modulos_necessarios;
+    g->intervalo_geracao = config.intervalo_geracao;
+    g->max_modulos = config.modulos_necessarios;
     
     g->qtd_tedax = num_tedax;
     for (int i = 0; i < num_tedax; i++) {
@@ -32,121 +98,276 @@ void inicializar_jogo(GameState *g, Dificuldade dificuldade, int num_tedax, int
         g->tedax[i].estado = TEDAX_LIVRE;
         g->tedax[i].modulo_atual = -1;
         g->tedax[i].bancada_atual = -1;
+        g->tedax[i].inicio_fila = 0;
         g->tedax[i].qtd_fila = 0;
-        g->tedax[i].fila_modulos[0] = -1;
+        g->tedax[i].capacidade_fila = config.profundidade_fila;
+        if (g->tedax[i].capacidade_fila < 1) g->tedax[i].capacidade_fila = 1;
+        if (g->tedax[i].capacidade_fila > MAX_FILA_TEDAX) g->tedax[i].capacidade_fila = MAX_FILA_TEDAX;
+        g->tedax[i].prazo_vencido = 0;
     }
     
-    g->qtd_bancadas = num_bancadas;
-    for (int i = 0; i < num_bancadas; i++) {
-        g->bancadas[i].id = i + 1;
-        g->bancadas[i].estado = BANCADA_LIVRE;
-        g->bancadas[i].tedax_ocupando = -1;
-        g->bancadas[i].tedax_esperando = -1;
-    }
+    bancadas_inicializar(g, num_bancadas);
+    g->politica = politica_configurada();
     
-    srand(time(NULL));
+    g->semente = semente;
+    g->estado_rng = g->semente ? g->semente : 0x9E3779B9u;
+    registrar_evento(EVENTO_PARTIDA_INICIO, g->semente, -1, -1, -1, dificuldade, NULL);
     
-    g->ticks_desde_ultimo_modulo = 0;
+    // Relógio e geração são os primeiros prazos; os dos módulos entram conforme o jogo anda
+    temporizador_inicializar(&g->roda);
+    temporizador_agendar(&g->roda, TEMPORIZADOR_RELOGIO, TICKS_POR_SEGUNDO);
+    temporizador_agendar(&g->roda, TEMPORIZADOR_GERACAO, g->intervalo_geracao);
+    g->threads_da_partida = 0;
+    g->geracao_pendente = 0;
     g->jogo_rodando = 1;
     g->jogo_terminou = 0;
     g->mensagem_erro[0] = '\0';
     g->erros_cometidos = 0;
+    utilizacao_reiniciar(g);
     
-    pthread_mutex_init(&g->mutex_jogo, NULL);
-    pthread_cond_init(&g->cond_modulo_disponivel, NULL);
-    pthread_cond_init(&g->cond_bancada_disponivel, NULL);
-    pthread_cond_init(&g->cond_tela_atualizada, NULL);
+    // Estoque começa vazio; thread_estoque (se houver) enche a partir do gerador
+    g->estoque.inicio = 0;
+    g->estoque.qtd = 0;
+    g->estoque.versao = 0;
+    g->estoque.estado_rng = g->estado_rng;
+    g->estoque.dificuldade = dificuldade;
+    g->estoque.ativo = 1;
     
     pthread_mutex_lock(&g->mutex_jogo);
-    for (int i = 0; i < config->modulos_iniciais; i++) {
+    for (int i = 0; i < config.modulos_iniciais; i++) {
         gerar_novo_modulo(g);
     }
+    repor_modulo_se_necessario(g);
     pthread_mutex_unlock(&g->mutex_jogo);
 }
 
-void finalizar_jogo(GameState *g) {
+void inicializar_jogo(GameState *g, Dificuldade dificuldade, int num_tedax, int num_bancadas) {
+    criar_sincronizacao_jogo(g);
+    reiniciar_jogo(g, dificuldade, num_tedax, num_bancadas);
+}
+
+// Fecha a partida (registro do fim); o GameState pode ser reiniciado em seguida
+void terminar_jogo(GameState *g) {
+    registrar_evento(EVENTO_PARTIDA_FIM, g->semente, -1, -1, -1,
+                     todos_modulos_resolvidos(g) && g->qtd_modulos > 0, NULL);
     g->jogo_rodando = 0;
-    pthread_mutex_destroy(&g->mutex_jogo);
-    pthread_cond_destroy(&g->cond_modulo_disponivel);
-    pthread_cond_destroy(&g->cond_bancada_disponivel);
-    pthread_cond_destroy(&g->cond_tela_atualizada);
 }
 
-void gerar_novo_modulo(GameState *g) {
-    if (g->qtd_modulos >= 100) {
+void finalizar_jogo(GameState *g) {
+    terminar_jogo(g);
+    destruir_sincronizacao_jogo(g);
+}
+
+// Fim da partida (terminou = 1 vitória/derrota, 0 saída do jogador), com mutex_jogo travado.
+// Quem espera em condição de mutex_jogo olha as flags antes de dormir, então o broadcast aqui
+// não se perde; as pausas de dormir_partida e o estoque são acordados pelas travas deles
+void encerrar_partida(GameState *g, int terminou) {
+    if (!g->jogo_rodando) {
         return;
     }
+    clock_gettime(CLOCK_MONOTONIC, &g->instante_encerramento);
+    if (terminou) {
+        g->jogo_terminou = 1;
+    }
+    g->jogo_rodando = 0;
     
-    Modulo *novo = &g->modulos[g->qtd_modulos];
-    novo->id = g->proximo_id_modulo++;
+    pthread_cond_broadcast(&g->cond_mural);
+    for (int i = 0; i < g->qtd_tedax; i++) {
+        pthread_cond_broadcast(&g->tedax[i].cond_trabalho);
+    }
+    pthread_cond_broadcast(&g->cond_modulo_disponivel);
+    pthread_cond_broadcast(&g->cond_bancada_disponivel);
     
-    const ConfigFase *config = obter_config_fase(g->dificuldade);
-    novo->tempo_total = config->tempo_minimo_execucao + (rand() % (config->tempo_variacao_execucao + 1));
-    novo->tempo_restante = novo->tempo_total;
+    pthread_mutex_lock(&g->mutex_despertar);
+    pthread_cond_broadcast(&g->cond_despertar);
+    pthread_mutex_unlock(&g->mutex_despertar);
+    parar_estoque_modulos(g);
+}
+
+// Pausa de até `nanos` que termina na hora se a partida acabar. Retorna 1 se a partida segue
+int dormir_partida(GameState *g, long nanos) {
+    struct timespec prazo;
+    clock_gettime(CLOCK_MONOTONIC, &prazo);
+    prazo.tv_sec += nanos / 1000000000L;
+    prazo.tv_nsec += nanos % 1000000000L;
+    if (prazo.tv_nsec >= 1000000000L) {
+        prazo.tv_sec++;
+        prazo.tv_nsec -= 1000000000L;
+    }
+    
+    pthread_mutex_lock(&g->mutex_despertar);
+    while (g->jogo_rodando && !g->jogo_terminou) {
+        if (pthread_cond_timedwait(&g->cond_despertar, &g->mutex_despertar, &prazo) == ETIMEDOUT) {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&g->mutex_despertar);
+    return g->jogo_rodando && !g->jogo_terminou;
+}
+
+// xorshift32: inteiro em [0, limite)
+int sortear(unsigned int *estado_rng, int limite) {
+    unsigned int x = *estado_rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *estado_rng = x;
+    return limite > 0 ? (int)(x % (unsigned int)limite) : 0;
+}
+
+// Sorteia tempo, tipo e conteúdo de um módulo; não toca na partida (roda sem mutex_jogo)
+static void sortear_conteudo_modulo(Modulo *novo, const ConfigFase *config, unsigned int *rng) {
+    novo->tempo_total = config->tempo_minimo_execucao + sortear(rng, config->tempo_variacao_execucao + 1);
     
     // Escolher tipo de módulo aleatoriamente com pesos por dificuldade
     // fácil: 40% fios, 40% botão, 20% hash
     // médio: 40% fios, 30% botão, 30% hash
     // difícil: 40% fios, 20% botão, 40% hash
-    int tipo_aleatorio = rand() % 100;
-    switch (g->dificuldade) {
+    int tipo_aleatorio = sortear(rng, 100);
+    Dificuldade base = config->dificuldade_modulos;
+    switch (base) {
         case DIFICULDADE_FACIL:
             if (tipo_aleatorio < 40) {
-                gerar_modulo_fios(novo, g->dificuldade);
+                gerar_modulo_fios(novo, base, rng);
             } else if (tipo_aleatorio < 80) {
-                gerar_modulo_botao(novo, g->dificuldade);
+                gerar_modulo_botao(novo, base, rng);
             } else {
-                gerar_modulo_senha(novo, g->dificuldade);
+                gerar_modulo_senha(novo, base, rng);
             }
             break;
         case DIFICULDADE_MEDIO:
             if (tipo_aleatorio < 40) {
-                gerar_modulo_fios(novo, g->dificuldade);
+                gerar_modulo_fios(novo, base, rng);
             } else if (tipo_aleatorio < 70) {
-                gerar_modulo_botao(novo, g->dificuldade);
+                gerar_modulo_botao(novo, base, rng);
             } else {
-                gerar_modulo_senha(novo, g->dificuldade);
+                gerar_modulo_senha(novo, base, rng);
             }
             break;
         case DIFICULDADE_DIFICIL:
             if (tipo_aleatorio < 40) {
-                gerar_modulo_fios(novo, g->dificuldade);
+                gerar_modulo_fios(novo, base, rng);
             } else if (tipo_aleatorio < 60) {
-                gerar_modulo_botao(novo, g->dificuldade);
+                gerar_modulo_botao(novo, base, rng);
             } else {
-                gerar_modulo_senha(novo, g->dificuldade);
+                gerar_modulo_senha(novo, base, rng);
             }
             break;
         default:
-            gerar_modulo_botao(novo, g->dificuldade);
+            gerar_modulo_botao(novo, base, rng);
             break;
     }
     
     novo->instrucao_digitada[0] = '\0';
-    novo->estado = MOD_PENDENTE;
-    novo->tempo_desde_resolvido = -1;
+}
+
+static int mesma_config(const ModuloPronto *pronto, const ConfigFase *config) {
+    return pronto->tempo_minimo_execucao == config->tempo_minimo_execucao &&
+           pronto->tempo_variacao_execucao == config->tempo_variacao_execucao &&
+           pronto->dificuldade_modulos == config->dificuldade_modulos;
+}
+
+// Tira o próximo módulo do estoque, se ele foi sorteado com a configuração atual (mutex_jogo travado)
+static int retirar_do_estoque(GameState *g, const ConfigFase *config, Modulo *destino) {
+    EstoqueModulos *e = &g->estoque;
+    int retirou = 0;
+    pthread_mutex_lock(&e->mutex);
+    if (e->qtd > 0 && mesma_config(&e->itens[e->inicio], config)) {
+        const ModuloPronto *pronto = &e->itens[e->inicio];
+        *destino = pronto->modulo;
+        g->estado_rng = pronto->estado_rng_depois;
+        e->inicio = (e->inicio + 1) % TAMANHO_ESTOQUE_MODULOS;
+        e->qtd--;
+        // Acorda a produção só na metade: a maioria das retiradas não faz chamada de sistema
+        if (e->qtd == TAMANHO_ESTOQUE_MODULOS / 2) {
+            pthread_cond_signal(&e->cond_espaco);
+        }
+        retirou = 1;
+    }
+    pthread_mutex_unlock(&e->mutex);
+    return retirou;
+}
+
+// Esvazia o estoque e faz a produção recomeçar do gerador atual da partida (mutex_jogo travado)
+void descartar_estoque_modulos(GameState *g) {
+    EstoqueModulos *e = &g->estoque;
+    pthread_mutex_lock(&e->mutex);
+    e->inicio = 0;
+    e->qtd = 0;
+    e->versao++;
+    e->estado_rng = g->estado_rng;
+    e->dificuldade = g->dificuldade;
+    pthread_cond_signal(&e->cond_espaco);
+    pthread_mutex_unlock(&e->mutex);
+}
+
+void parar_estoque_modulos(GameState *g) {
+    pthread_mutex_lock(&g->estoque.mutex);
+    g->estoque.ativo = 0;
+    pthread_cond_signal(&g->estoque.cond_espaco);
+    pthread_mutex_unlock(&g->estoque.mutex);
+}
+
+void gerar_novo_modulo(GameState *g) {
+    if (g->qtd_modulos >= MAX_MODULOS) {
+        return;
+    }
+    
+    int idx = g->qtd_modulos;
+    Modulo *novo = &g->modulos[idx];
+    g->quente.id[idx] = g->proximo_id_modulo++;
+    
+    // Normalmente já vem pronto do estoque; vazio (ou sorteado com outra fases.cfg), sorteia aqui
+    ConfigFase config = obter_config_fase(g->dificuldade);
+    if (!retirar_do_estoque(g, &config, novo)) {
+        sortear_conteudo_modulo(novo, &config, &g->estado_rng);
+        descartar_estoque_modulos(g);
+    }
+    
+    g->quente.estado[idx] = MOD_PENDENTE;
+    g->quente.reservado[idx] = 0;
+    g->pendentes_livres++;
+    registrar_evento(EVENTO_MODULO_ESTADO, g->semente, -1, -1, g->quente.id[idx], MOD_PENDENTE, NULL);
+    novo->criado_em = g->tempo_total_partida - g->tempo_restante;
+    novo->tempo_solucao = -1;
+    novo->atribuido_no_tick = -1;
+    novo->espera_inicio = -1;
     
     g->qtd_modulos++;
+    g->versao_mural++;
     pthread_cond_broadcast(&g->cond_modulo_disponivel);
 }
 
+// Avança um segundo do relógio da partida e verifica vitória/derrota (mutex_jogo travado)
+// Retorna 1 se a partida terminou
+static int avancar_segundo_partida(GameState *g) {
+    g->tempo_restante--;
+    
+    if ((todos_modulos_resolvidos(g) && g->qtd_modulos > 0) || g->tempo_restante <= 0) {
+        encerrar_partida(g, 1);
+        return 1;
+    }
+    return 0;
+}
+
+// Os laços abaixo varrem só os vetores quentes e não têm desvio no corpo,
+// então o compilador consegue vetorizá-los (-O3)
 int contar_modulos_resolvidos(const GameState *g) {
+    const unsigned char *estado = g->quente.estado;
     int resolvidos = 0;
     for (int i = 0; i < g->qtd_modulos; i++) {
-        if (g->modulos[i].estado == MOD_RESOLVIDO) {
-            resolvidos++;
-        }
+        resolvidos += (estado[i] == MOD_RESOLVIDO);
     }
     return resolvidos;
 }
 
 int tem_modulos_pendentes(const GameState *g) {
+    const unsigned char *estado = g->quente.estado;
+    int pendentes = 0;
     for (int i = 0; i < g->qtd_modulos; i++) {
-        if (g->modulos[i].estado == MOD_PENDENTE) {
-            return 1;
-        }
+        pendentes += (estado[i] == MOD_PENDENTE);
     }
-    return 0;
+    return pendentes > 0;
 }
 
 int todos_modulos_resolvidos(const GameState *g) {
@@ -180,6 +401,19 @@ const char* nome_estado_modulo(EstadoModulo estado) {
     }
 }
 
+const char* nome_estado_tedax(EstadoTedax estado) {
+    switch (estado) {
+        case TEDAX_LIVRE:
+            return "LIVRE";
+        case TEDAX_OCUPADO:
+            return "OCUPADO";
+        case TEDAX_ESPERANDO:
+            return "ESPERANDO";
+        default:
+            return "DESCONHECIDO";
+    }
+}
+
 const char* nome_dificuldade(Dificuldade dificuldade) {
     switch (dificuldade) {
         case DIFICULDADE_FACIL:
@@ -188,324 +422,342 @@ const char* nome_dificuldade(Dificuldade dificuldade) {
             return "MEDIO";
         case DIFICULDADE_DIFICIL:
             return "DIFICIL";
+        case DIFICULDADE_CUSTOM:
+            return "CUSTOM";
         default:
             return "DESCONHECIDA";
     }
 }
 
+// Sem módulos pendentes no mural, repõe um na hora (mutex_jogo travado)
+static void repor_modulo_se_necessario(GameState *g) {
+    if (!tem_modulos_pendentes(g) && g->qtd_modulos < g->max_modulos) {
+        gerar_novo_modulo(g);
+    }
+}
+
+// Prazo de geração vencido: gera o módulo e rearma com o intervalo atual (mutex_jogo travado)
+static void processar_geracao(GameState *g) {
+    // Acompanha recarga de fases.cfg durante a partida
+    g->intervalo_geracao = obter_config_fase(g->dificuldade).intervalo_geracao;
+    
+    if (g->qtd_modulos < g->max_modulos) {
+        gerar_novo_modulo(g);
+        temporizador_agendar(&g->roda, TEMPORIZADOR_GERACAO, g->intervalo_geracao);
+    }
+    repor_modulo_se_necessario(g);
+    painel_publicar(g);
+}
+
+// Espera em cond por um aviso do tick ou pelo fim da partida (encerrar_partida)
+static void esperar_aviso(GameState *g, pthread_cond_t *cond) {
+    pthread_cond_wait(cond, &g->mutex_jogo);
+}
+
 void* thread_mural(void* arg) {
     GameState *g = (GameState*)arg;
-    struct timespec ts;
-    ts.tv_sec = 0;
-    ts.tv_nsec = 200000000L;
     
+    pthread_mutex_lock(&g->mutex_jogo);
     while (g->jogo_rodando && !g->jogo_terminou) {
-        pthread_mutex_lock(&g->mutex_jogo);
-        
-        if (g->qtd_modulos < g->max_modulos) {
-            g->ticks_desde_ultimo_modulo++;
-            
-            if (g->ticks_desde_ultimo_modulo >= g->intervalo_geracao) {
-                gerar_novo_modulo(g);
-                g->ticks_desde_ultimo_modulo = 0;
-            }
+        if (g->geracao_pendente) {
+            g->geracao_pendente = 0;
+            processar_geracao(g);
+            continue;
         }
-        
-        if (!tem_modulos_pendentes(g) && g->qtd_modulos < g->max_modulos) {
-            gerar_novo_modulo(g);
+        esperar_aviso(g, &g->cond_mural);
+    }
+    pthread_mutex_unlock(&g->mutex_jogo);
+    
+    return NULL;
+}
+
+
+// Mantém o estoque cheio: sorteia sem mutex_jogo, continuando do gerador do último módulo
+// em estoque, e só entrega se ninguém descartou o estoque enquanto isso
+void* thread_estoque(void* arg) {
+    GameState *g = (GameState*)arg;
+    EstoqueModulos *e = &g->estoque;
+    
+    pthread_mutex_lock(&e->mutex);
+    while (e->ativo) {
+        if (e->qtd >= TAMANHO_ESTOQUE_MODULOS) {
+            pthread_cond_wait(&e->cond_espaco, &e->mutex);
+            continue;
         }
+        unsigned int versao = e->versao;
+        unsigned int rng = e->estado_rng;
+        ConfigFase config = obter_config_fase(e->dificuldade);
+        pthread_mutex_unlock(&e->mutex);
         
-        pthread_mutex_unlock(&g->mutex_jogo);
+        ModuloPronto pronto;
+        pronto.tempo_minimo_execucao = config.tempo_minimo_execucao;
+        pronto.tempo_variacao_execucao = config.tempo_variacao_execucao;
+        pronto.dificuldade_modulos = config.dificuldade_modulos;
+        sortear_conteudo_modulo(&pronto.modulo, &config, &rng);
+        pronto.estado_rng_depois = rng;
         
-        nanosleep(&ts, NULL);
+        pthread_mutex_lock(&e->mutex);
+        if (e->versao == versao && e->qtd < TAMANHO_ESTOQUE_MODULOS) {
+            e->itens[(e->inicio + e->qtd) % TAMANHO_ESTOQUE_MODULOS] = pronto;
+            e->qtd++;
+            e->estado_rng = rng;
+        }
     }
+    pthread_mutex_unlock(&e->mutex);
     
     return NULL;
 }
 
 void* thread_exibicao(void* arg) {
     GameState *g = (GameState*)arg;
-    struct timespec ts;
-    ts.tv_sec = 0;
-    ts.tv_nsec = 200000000L;
-    
     extern char buffer_instrucao_global[64];
     
-    inicializar_ncurses();
-    
-    if (has_colors()) {
-        start_color();
-        init_pair(1, COLOR_CYAN, COLOR_BLACK);
-        init_pair(2, COLOR_GREEN, COLOR_BLACK);
-        init_pair(3, COLOR_YELLOW, COLOR_BLACK);
-        init_pair(4, COLOR_RED, COLOR_BLACK);
-        init_pair(5, COLOR_BLUE, COLOR_BLACK);
-        init_pair(6, COLOR_WHITE, COLOR_BLACK);
-        init_pair(7, COLOR_BLACK, COLOR_WHITE);
-    }
-    
+    // A sessão ncurses já está aberta (main); aqui só se desenha
     while (g->jogo_rodando && !g->jogo_terminou) {
+        struct timespec antes_trava, com_trava;
+        clock_gettime(CLOCK_MONOTONIC, &antes_trava);
         pthread_mutex_lock(&g->mutex_jogo);
+        clock_gettime(CLOCK_MONOTONIC, &com_trava);
         desenhar_tela(g, buffer_instrucao_global);
+        latencia_quadro_apresentado(&antes_trava, &com_trava);
         pthread_mutex_unlock(&g->mutex_jogo);
-        nanosleep(&ts, NULL);
+        dormir_partida(g, 200000000L);
     }
     
-    
     return NULL;
 }
 
-void* thread_tedax(void* arg) {
-    typedef struct {
-        GameState *g;
-        int tedax_id;
-    } TedaxArgs;
+// 1 se o módulo conta em `pendentes_livres`
+static int pendente_livre(const GameState *g, int m) {
+    return g->quente.estado[m] == MOD_PENDENTE && !g->quente.reservado[m];
+}
+
+// Muda o estado de um módulo já publicado e registra a transição (mutex_jogo travado)
+static void mudar_estado_modulo(GameState *g, int m, EstadoModulo estado) {
+    if (g->quente.estado[m] != estado) {
+        registrar_evento(EVENTO_MODULO_ESTADO, g->semente, -1, -1, g->quente.id[m], estado, NULL);
+        g->versao_mural++;
+    }
+    g->pendentes_livres -= pendente_livre(g, m);
+    g->quente.estado[m] = (unsigned char)estado;
+    g->pendentes_livres += pendente_livre(g, m);
+}
+
+// Marca ou libera a reserva do módulo na fila de algum tedax (mutex_jogo travado)
+static void reservar_modulo(GameState *g, int m, int reservado) {
+    g->pendentes_livres -= pendente_livre(g, m);
+    g->quente.reservado[m] = (unsigned char)reservado;
+    g->pendentes_livres += pendente_livre(g, m);
+}
+
+// Refaz o contador a partir dos vetores quentes (após carregar um salvamento)
+void recontar_pendentes_livres(GameState *g) {
+    g->pendentes_livres = 0;
+    for (int i = 0; i < g->qtd_modulos; i++) {
+        g->pendentes_livres += pendente_livre(g, i);
+    }
+}
+
+// Retira da fila o próximo módulo ainda válido e o coloca em execução (mutex_jogo travado)
+static void puxar_proximo_da_fila(GameState *g, int tedax_idx, int bancada_preferida) {
+    Tedax *tedax = &g->tedax[tedax_idx];
+    
+    while (tedax->qtd_fila > 0) {
+        // A política escolhe o item; os que vêm antes dele na fila mantêm a ordem
+        int escolhido = escolher_na_fila_tedax(g, tedax);
+        ItemFilaTedax item = tedax->fila[(tedax->inicio_fila + escolhido) % MAX_FILA_TEDAX];
+        for (int k = escolhido; k > 0; k--) {
+            tedax->fila[(tedax->inicio_fila + k) % MAX_FILA_TEDAX] =
+                tedax->fila[(tedax->inicio_fila + k - 1) % MAX_FILA_TEDAX];
+        }
+        tedax->inicio_fila = (tedax->inicio_fila + 1) % MAX_FILA_TEDAX;
+        tedax->qtd_fila--;
+        
+        if (item.modulo_idx < 0 || item.modulo_idx >= g->qtd_modulos) {
+            continue;
+        }
+        int m = item.modulo_idx;
+        reservar_modulo(g, m, 0);
+        if (g->quente.estado[m] != MOD_PENDENTE) {
+            continue;
+        }
+        
+        tedax->modulo_atual = m;
+        mudar_estado_modulo(g, m, MOD_EM_EXECUCAO);
+        
+        // Bancada do comando; senão a anterior; senão qualquer livre; senão fila de espera
+        int bancada_idx = (item.bancada_idx >= 0) ? item.bancada_idx : bancada_preferida;
+        if (!bancada_ocupar(g, bancada_idx, tedax_idx) &&
+            bancada_ocupar_qualquer(g, tedax_idx) < 0) {
+            bancada_entrar_espera(g, item.bancada_idx, tedax_idx);
+        }
+        return;
+    }
+}
+
+// Tedax ganhou a bancada: o módulo passa a contar a partir de agora (mutex_jogo travado)
+void iniciar_contagem_modulo(GameState *g, int tedax_idx) {
+    Tedax *t = &g->tedax[tedax_idx];
+    if (t->modulo_atual < 0) {
+        return;
+    }
+    
+    int m = t->modulo_atual;
+    mudar_estado_modulo(g, m, MOD_EM_EXECUCAO);
+    utilizacao_modulo_iniciado(g, m);
+    t->prazo_vencido = 0;
+    
+    // Sem instrução o módulo fica parado na bancada, como antes
+    if (g->modulos[m].instrucao_digitada[0] == '\0') {
+        temporizador_cancelar(&g->roda, TEMPORIZADOR_TEDAX(tedax_idx));
+        return;
+    }
+    temporizador_agendar(&g->roda, TEMPORIZADOR_TEDAX(tedax_idx),
+                         g->modulos[m].tempo_total * TICKS_POR_SEGUNDO);
+}
+
+int tempo_restante_modulo(const GameState *g, int modulo_idx) {
+    if (g->quente.estado[modulo_idx] == MOD_RESOLVIDO) {
+        return 0;
+    }
+    for (int i = 0; i < g->qtd_tedax; i++) {
+        const Tedax *t = &g->tedax[i];
+        if (t->estado != TEDAX_OCUPADO || t->modulo_atual != modulo_idx) {
+            continue;
+        }
+        int ticks = temporizador_restante(&g->roda, TEMPORIZADOR_TEDAX(i));
+        if (ticks >= 0) {
+            return (ticks + TICKS_POR_SEGUNDO - 1) / TICKS_POR_SEGUNDO;
+        }
+        if (t->prazo_vencido) {
+            return 0;
+        }
+    }
+    return g->modulos[modulo_idx].tempo_total;
+}
+
+// -1 se o módulo não está resolvido ou já saiu do mural
+int segundos_desde_resolvido(const GameState *g, int modulo_idx) {
+    int ticks = temporizador_restante(&g->roda, TEMPORIZADOR_RESOLVIDO(modulo_idx));
+    if (ticks < 0) {
+        return -1;
+    }
+    return (SEGUNDOS_RESOLVIDO_VISIVEL * TICKS_POR_SEGUNDO - ticks) / TICKS_POR_SEGUNDO;
+}
+
+// Prazo do módulo do tedax vencido: valida a instrução, libera a bancada e emenda
+// o próximo da fila (mutex_jogo travado)
+static void concluir_modulo_tedax(GameState *g, int tedax_idx) {
+    Tedax *tedax = &g->tedax[tedax_idx];
     
+    if (tedax->estado != TEDAX_OCUPADO || tedax->modulo_atual < 0) {
+        return;
+    }
+    
+    int m = tedax->modulo_atual;
+    Modulo *mod = &g->modulos[m];
+    ModulosQuentes *q = &g->quente;
+    
+    if (q->estado[m] != MOD_RESOLVIDO) {
+        if (validar_instrucao_modulo(mod, mod->instrucao_digitada)) {
+            mudar_estado_modulo(g, m, MOD_RESOLVIDO);
+            mod->tempo_solucao = (g->tempo_total_partida - g->tempo_restante) - mod->criado_em;
+            temporizador_agendar(&g->roda, TEMPORIZADOR_RESOLVIDO(m),
+                                 SEGUNDOS_RESOLVIDO_VISIVEL * TICKS_POR_SEGUNDO);
+            // Vitória vale na hora, sem esperar o próximo segundo do relógio
+            if (todos_modulos_resolvidos(g)) {
+                encerrar_partida(g, 1);
+            }
+        } else {
+            mudar_estado_modulo(g, m, MOD_PENDENTE);
+            mod->instrucao_digitada[0] = '\0';
+            g->erros_cometidos++;
+            registrar_evento(EVENTO_ERRO, g->semente, tedax->id, -1, q->id[m], g->erros_cometidos, NULL);
+        }
+    }
+    
+    // Libera a bancada (entregue ao primeiro da fila de espera, se houver)
+    int bancada_anterior = tedax->bancada_atual;
+    bancada_liberar(g, bancada_anterior);
+    tedax->bancada_atual = -1;
+    tedax->modulo_atual = -1;
+    tedax->estado = TEDAX_LIVRE;
+    
+    // Emenda o próximo módulo da fila na hora
+    puxar_proximo_da_fila(g, tedax_idx, bancada_anterior);
+    
+    repor_modulo_se_necessario(g);
+    painel_publicar(g);
+    
+    pthread_cond_broadcast(&g->cond_modulo_disponivel);
+}
+
+void* thread_tedax(void* arg) {
     TedaxArgs *args = (TedaxArgs*)arg;
     GameState *g = args->g;
     int tedax_id = args->tedax_id;
     Tedax *tedax = &g->tedax[tedax_id];
     
-    struct timespec ts;
-    ts.tv_sec = 1;
-    ts.tv_nsec = 0;
-    
+    // Não conta tempo: a roda avisa (prazo_vencido + cond_trabalho) quando o módulo termina
+    pthread_mutex_lock(&g->mutex_jogo);
     while (g->jogo_rodando && !g->jogo_terminou) {
-        pthread_mutex_lock(&g->mutex_jogo);
-        
-        for (int i = 0; i < g->qtd_modulos; i++) {
-            if (g->modulos[i].estado == MOD_RESOLVIDO && g->modulos[i].tempo_desde_resolvido >= 0) {
-                g->modulos[i].tempo_desde_resolvido++;
-            }
+        if (tedax->prazo_vencido) {
+            tedax->prazo_vencido = 0;
+            concluir_modulo_tedax(g, tedax_id);
+            continue;
         }
-        
-        // Verifica se tedax em espera pode ocupar bancada liberada
-        if (tedax->estado == TEDAX_ESPERANDO && tedax->bancada_atual >= 0) {
-            int bancada_idx = tedax->bancada_atual;
-            if (g->bancadas[bancada_idx].estado == BANCADA_LIVRE && 
-                g->bancadas[bancada_idx].tedax_esperando == tedax->id) {
-                g->bancadas[bancada_idx].estado = BANCADA_OCUPADA;
-                g->bancadas[bancada_idx].tedax_ocupando = tedax->id;
-                g->bancadas[bancada_idx].tedax_esperando = -1;
-                tedax->estado = TEDAX_OCUPADO;
-                
-                if (tedax->modulo_atual >= 0) {
-                    Modulo *mod_esperando = &g->modulos[tedax->modulo_atual];
-                    if (mod_esperando->estado != MOD_EM_EXECUCAO) {
-                        mod_esperando->estado = MOD_EM_EXECUCAO;
-                    }
-                    if (mod_esperando->tempo_restante <= 0) {
-                        mod_esperando->tempo_restante = mod_esperando->tempo_total;
-                    }
-                }
-            } else if (g->bancadas[bancada_idx].estado == BANCADA_OCUPADA && 
-                       g->bancadas[bancada_idx].tedax_ocupando != tedax->id &&
-                       g->bancadas[bancada_idx].tedax_esperando != tedax->id) {
-                // Outro tedax ocupou: procurar outra bancada livre
-                int bancada_encontrada = 0;
-                for (int i = 0; i < g->qtd_bancadas; i++) {
-                    if (g->bancadas[i].estado == BANCADA_LIVRE) {
-                        if (bancada_idx >= 0 && bancada_idx < g->qtd_bancadas) {
-                            if (g->bancadas[bancada_idx].tedax_esperando == tedax->id) {
-                                g->bancadas[bancada_idx].tedax_esperando = -1;
-                            }
-                        }
-                        tedax->bancada_atual = i;
-                        g->bancadas[i].estado = BANCADA_OCUPADA;
-                        g->bancadas[i].tedax_ocupando = tedax->id;
-                        g->bancadas[i].tedax_esperando = -1;
-                        tedax->estado = TEDAX_OCUPADO;
-                        bancada_encontrada = 1;
-                        
-                        if (tedax->modulo_atual >= 0) {
-                            Modulo *mod_esperando = &g->modulos[tedax->modulo_atual];
-                            if (mod_esperando->estado != MOD_EM_EXECUCAO) {
-                                mod_esperando->estado = MOD_EM_EXECUCAO;
-                            }
-                            if (mod_esperando->tempo_restante <= 0) {
-                                mod_esperando->tempo_restante = mod_esperando->tempo_total;
-                            }
-                        }
-                        break;
-                    }
-                }
-                
-                if (!bancada_encontrada) {
-                    // Nenhuma livre: manter em espera na primeira disponível
-                    int nova_bancada_idx = 0;
-                    if (bancada_idx != nova_bancada_idx) {
-                        if (bancada_idx >= 0 && bancada_idx < g->qtd_bancadas) {
-                            if (g->bancadas[bancada_idx].tedax_esperando == tedax->id) {
-                                g->bancadas[bancada_idx].tedax_esperando = -1;
-                            }
-                        }
-                        if (g->bancadas[nova_bancada_idx].tedax_esperando < 0) {
-                            tedax->bancada_atual = nova_bancada_idx;
-                            g->bancadas[nova_bancada_idx].tedax_esperando = tedax->id;
-                        }
-                    }
-                }
-            }
-        }
-        
-        // Processa módulo atribuído ao tedax
-        if (tedax->estado == TEDAX_OCUPADO && tedax->modulo_atual >= 0) {
-            Modulo *mod = &g->modulos[tedax->modulo_atual];
-            
-            if (mod->estado == MOD_RESOLVIDO) {
-                if (tedax->bancada_atual >= 0) {
-                    g->bancadas[tedax->bancada_atual].estado = BANCADA_LIVRE;
-                    g->bancadas[tedax->bancada_atual].tedax_ocupando = -1;
-                }
-                tedax->estado = TEDAX_LIVRE;
-                tedax->modulo_atual = -1;
-                tedax->bancada_atual = -1;
-                pthread_mutex_unlock(&g->mutex_jogo);
-                nanosleep(&ts, NULL);
-                continue;
-            }
-            
-            if (mod->estado != MOD_EM_EXECUCAO) {
-                mod->estado = MOD_EM_EXECUCAO;
-                if (mod->tempo_restante <= 0) {
-                    mod->tempo_restante = mod->tempo_total;
-                }
-            }
-            
-            if (strlen(mod->instrucao_digitada) == 0) {
-                pthread_mutex_unlock(&g->mutex_jogo);
-                nanosleep(&ts, NULL);
-                continue;
+        esperar_aviso(g, &tedax->cond_trabalho);
+    }
+    pthread_mutex_unlock(&g->mutex_jogo);
+    
+    return NULL;
+}
+
+// Avança a partida em um tick de 0.2s disparando os prazos vencidos na roda (mutex_jogo travado).
+// Com threads_da_partida, mural e tedax só são avisados; sem, o trabalho deles roda aqui
+// (servidor, que agenda muitas partidas em poucas threads). Retorna 1 se a partida terminou
+int avancar_tick_partida(GameState *g) {
+    if (!g->jogo_rodando || g->jogo_terminou) {
+        return 1;
+    }
+    
+    // Estado de tedax e bancadas durante o tick que termina agora
+    utilizacao_tick(g);
+    
+    int vencidos[MAX_TEMPORIZADORES];
+    int qtd = temporizador_avancar(&g->roda, vencidos);
+    
+    for (int k = 0; k < qtd; k++) {
+        int id = vencidos[k];
+        if (id == TEMPORIZADOR_RELOGIO) {
+            temporizador_agendar(&g->roda, TEMPORIZADOR_RELOGIO, TICKS_POR_SEGUNDO);
+            avancar_segundo_partida(g);
+        } else if (id == TEMPORIZADOR_GERACAO) {
+            if (g->threads_da_partida) {
+                g->geracao_pendente = 1;
+                pthread_cond_signal(&g->cond_mural);
+            } else {
+                processar_geracao(g);
             }
-            
-            mod->tempo_restante--;
-            
-            if (mod->tempo_restante <= 0) {
-                if (validar_instrucao_modulo(mod, mod->instrucao_digitada)) {
-                    mod->estado = MOD_RESOLVIDO;
-                    mod->tempo_desde_resolvido = 0;
-                } else {
-                    mod->estado = MOD_PENDENTE;
-                    mod->tempo_restante = mod->tempo_total;
-                    mod->instrucao_digitada[0] = '\0';
-                    mod->tempo_desde_resolvido = -1;
-                    g->erros_cometidos++;
-                }
-                
-                if (tedax->bancada_atual >= 0) {
-                    int bancada_idx = tedax->bancada_atual;
-                    g->bancadas[bancada_idx].estado = BANCADA_LIVRE;
-                    g->bancadas[bancada_idx].tedax_ocupando = -1;
-                    
-                    // Atribui bancada liberada ao tedax em espera (evita condição de corrida)
-                    if (g->bancadas[bancada_idx].estado == BANCADA_LIVRE && 
-                        g->bancadas[bancada_idx].tedax_esperando >= 0) {
-                        int tedax_esperando_id = g->bancadas[bancada_idx].tedax_esperando;
-                        for (int i = 0; i < g->qtd_tedax; i++) {
-                            if (g->tedax[i].id == tedax_esperando_id && 
-                                g->tedax[i].estado == TEDAX_ESPERANDO &&
-                                g->tedax[i].bancada_atual == bancada_idx) {
-                                if (g->bancadas[bancada_idx].estado == BANCADA_LIVRE) {
-                                    g->bancadas[bancada_idx].estado = BANCADA_OCUPADA;
-                                    g->bancadas[bancada_idx].tedax_ocupando = g->tedax[i].id;
-                                    g->bancadas[bancada_idx].tedax_esperando = -1;
-                                    g->tedax[i].estado = TEDAX_OCUPADO;
-                                    
-                                    if (g->tedax[i].modulo_atual >= 0) {
-                                        Modulo *mod_esperando = &g->modulos[g->tedax[i].modulo_atual];
-                                        if (mod_esperando->estado != MOD_EM_EXECUCAO) {
-                                            mod_esperando->estado = MOD_EM_EXECUCAO;
-                                        }
-                                        if (mod_esperando->tempo_restante <= 0) {
-                                            mod_esperando->tempo_restante = mod_esperando->tempo_total;
-                                        }
-                                    }
-                                }
-                                break;
-                            }
-                        }
-                    }
-                    
-                    pthread_cond_broadcast(&g->cond_bancada_disponivel);
-                }
-                
-                // Processa próximo módulo da fila (máximo 1)
-                if (tedax->qtd_fila > 0) {
-                    int proximo_modulo_idx = tedax->fila_modulos[0];
-                    if (proximo_modulo_idx >= 0 && proximo_modulo_idx < g->qtd_modulos) {
-                        Modulo *prox_mod = &g->modulos[proximo_modulo_idx];
-                        if (prox_mod->estado == MOD_RESOLVIDO) {
-                            tedax->fila_modulos[0] = -1;
-                            tedax->qtd_fila = 0;
-                        } else {
-                            tedax->fila_modulos[0] = -1;
-                            tedax->qtd_fila = 0;
-                            if (tedax->bancada_atual >= 0 && 
-                                g->bancadas[tedax->bancada_atual].estado == BANCADA_LIVRE) {
-                                tedax->modulo_atual = proximo_modulo_idx;
-                                prox_mod->estado = MOD_EM_EXECUCAO;
-                                prox_mod->tempo_restante = prox_mod->tempo_total;
-                                g->bancadas[tedax->bancada_atual].estado = BANCADA_OCUPADA;
-                                g->bancadas[tedax->bancada_atual].tedax_ocupando = tedax->id;
-                            } else {
-                                int bancada_encontrada = 0;
-                                for (int i = 0; i < g->qtd_bancadas; i++) {
-                                    if (g->bancadas[i].estado == BANCADA_LIVRE) {
-                                        tedax->modulo_atual = proximo_modulo_idx;
-                                        tedax->bancada_atual = i;
-                                        prox_mod->estado = MOD_EM_EXECUCAO;
-                                        prox_mod->tempo_restante = prox_mod->tempo_total;
-                                        g->bancadas[i].estado = BANCADA_OCUPADA;
-                                        g->bancadas[i].tedax_ocupando = tedax->id;
-                                        bancada_encontrada = 1;
-                                        break;
-                                    }
-                                }
-                                
-                                if (!bancada_encontrada) {
-                                    if (g->qtd_bancadas > 0) {
-                                        int bancada_idx = 0;
-                                        tedax->modulo_atual = proximo_modulo_idx;
-                                        tedax->bancada_atual = bancada_idx;
-                                        tedax->estado = TEDAX_ESPERANDO;
-                                        prox_mod->estado = MOD_EM_EXECUCAO;
-                                        prox_mod->tempo_restante = prox_mod->tempo_total;
-                                        g->bancadas[bancada_idx].tedax_esperando = tedax->id;
-                                    } else {
-                                        prox_mod->estado = MOD_PENDENTE;
-                                        tedax->modulo_atual = -1;
-                                        tedax->bancada_atual = -1;
-                                        tedax->estado = TEDAX_LIVRE;
-                                    }
-                                }
-                            }
-                        }
-                    } else {
-                        tedax->fila_modulos[0] = -1;
-                        tedax->qtd_fila = 0;
-                    }
-                } else {
-                    tedax->estado = TEDAX_LIVRE;
-                    tedax->modulo_atual = -1;
-                    tedax->bancada_atual = -1;
-                }
-                
-                if (!tem_modulos_pendentes(g) && g->qtd_modulos < g->max_modulos) {
-                    gerar_novo_modulo(g);
-                }
-                
-                pthread_cond_broadcast(&g->cond_modulo_disponivel);
+        } else if (id < TEMPORIZADOR_RESOLVIDO(0)) {
+            int tedax_idx = id - TEMPORIZADOR_TEDAX(0);
+            if (g->threads_da_partida) {
+                g->tedax[tedax_idx].prazo_vencido = 1;
+                pthread_cond_signal(&g->tedax[tedax_idx].cond_trabalho);
+            } else {
+                concluir_modulo_tedax(g, tedax_idx);
             }
+        } else {
+            // TEMPORIZADOR_RESOLVIDO: o módulo some do mural por estar desarmado
+            g->versao_mural++;
         }
-        
-        pthread_mutex_unlock(&g->mutex_jogo);
-        nanosleep(&ts, NULL);
     }
     
-    free(args);
-    return NULL;
+    painel_publicar(g);
+    return g->jogo_terminou;
 }
 
+
 // Processa comando formato T1B1M1:ppp
 int processar_comando(const char* buffer, GameState *g, 
                       int *tedax_idx, int *bancada_idx, int *modulo_idx, 
@@ -546,8 +798,12 @@ int processar_comando(const char* buffer, GameState *g,
         return 1;
     }
     
+    // Linhas vêm de clientes (protocolo, servidor): comando maior que o buffer é inválido
     char comando[32];
-    strncpy(comando, buffer, len_comando);
+    if (len_comando >= (int)sizeof(comando)) {
+        return 0;
+    }
+    memcpy(comando, buffer, len_comando);
     comando[len_comando] = '\0';
     
     int i = 0;
@@ -556,7 +812,9 @@ int processar_comando(const char* buffer, GameState *g,
             i++;
             int num = 0;
             while (i < len_comando && comando[i] >= '0' && comando[i] <= '9') {
-                num = num * 10 + (comando[i] - '0');
+                if (num < 100000) {
+                    num = num * 10 + (comando[i] - '0');
+                }
                 i++;
             }
             if (num >= 1 && num <= g->qtd_tedax) {
@@ -568,7 +826,9 @@ int processar_comando(const char* buffer, GameState *g,
             i++;
             int num = 0;
             while (i < len_comando && comando[i] >= '0' && comando[i] <= '9') {
-                num = num * 10 + (comando[i] - '0');
+                if (num < 100000) {
+                    num = num * 10 + (comando[i] - '0');
+                }
                 i++;
             }
             if (num >= 1 && num <= g->qtd_bancadas) {
@@ -580,12 +840,14 @@ int processar_comando(const char* buffer, GameState *g,
             i++;
             int num = 0;
             while (i < len_comando && comando[i] >= '0' && comando[i] <= '9') {
-                num = num * 10 + (comando[i] - '0');
+                if (num < 100000) {
+                    num = num * 10 + (comando[i] - '0');
+                }
                 i++;
             }
             int encontrado = 0;
             for (int j = 0; j < g->qtd_modulos; j++) {
-                if (g->modulos[j].id == num) {
+                if (g->quente.id[j] == num) {
                     *modulo_idx = j;
                     encontrado = 1;
                     break;
@@ -602,22 +864,175 @@ int processar_comando(const char* buffer, GameState *g,
     return 1;
 }
 
+// Aplica um comando T<n>B<n>M<n>:<instr> ao jogo (mutex_jogo travado)
+// Retorna 1 se aceito; se rejeitado, retorna 0 e preenche mensagem_erro
+static int aplicar_comando(GameState *g, const char *buffer) {
+    g->mensagem_erro[0] = '\0';
+    
+    int tedax_idx = -1, bancada_idx = -1, modulo_idx = -1;
+    char instrucao[16] = "";
+    
+    if (processar_comando(buffer, g, &tedax_idx, &bancada_idx, &modulo_idx, instrucao)) {
+        // Valores não especificados ficam a cargo da política da partida
+        if (tedax_idx == -1) {
+            tedax_idx = escolher_tedax(g);
+        }
+        
+        // Bancada não especificada fica a cargo do alocador (primeira livre ou fila global)
+        
+        if (modulo_idx == -1) {
+            modulo_idx = escolher_modulo(g);
+        }
+        
+        int valido = 1;
+        
+        if (tedax_idx < 0 || tedax_idx >= g->qtd_tedax) {
+            valido = 0;
+        }
+        
+        if (g->qtd_bancadas <= 0 || bancada_idx >= g->qtd_bancadas) {
+            valido = 0;
+        }
+        
+        if (modulo_idx < 0 || modulo_idx >= g->qtd_modulos) {
+            valido = 0;
+        } else if (g->quente.estado[modulo_idx] != MOD_PENDENTE ||
+                   g->quente.reservado[modulo_idx]) {
+            valido = 0;
+        }
+        
+        if (valido && strlen(instrucao) > 0) {
+            Modulo *mod = &g->modulos[modulo_idx];
+            ModulosQuentes *q = &g->quente;
+            Tedax *t = &g->tedax[tedax_idx];
+            
+            // Recusado não deixa rastro: o módulo só é tocado depois desta verificação
+            if (t->estado == TEDAX_OCUPADO && t->qtd_fila >= t->capacidade_fila) {
+                strncpy(g->mensagem_erro, "Fila do tedax cheia", 63);
+                g->mensagem_erro[63] = '\0';
+                return 0;
+            }
+            
+            strncpy(mod->instrucao_digitada, instrucao, 15);
+            mod->instrucao_digitada[15] = '\0';
+            
+            if (t->estado == TEDAX_OCUPADO) {
+                // Adiciona à fila circular do tedax (capacidade definida pela fase)
+                int pos = (t->inicio_fila + t->qtd_fila) % MAX_FILA_TEDAX;
+                t->fila[pos].modulo_idx = modulo_idx;
+                t->fila[pos].bancada_idx = bancada_idx;
+                t->qtd_fila++;
+                mudar_estado_modulo(g, modulo_idx, MOD_PENDENTE);
+                reservar_modulo(g, modulo_idx, 1);
+                utilizacao_modulo_atribuido(g, modulo_idx);
+            } else {
+                // Limpa espera anterior se tedax estava esperando
+                if (t->estado == TEDAX_ESPERANDO) {
+                    bancada_sair_espera(g, tedax_idx);
+                    
+                    if (t->modulo_atual >= 0 && t->modulo_atual < g->qtd_modulos) {
+                        int anterior = t->modulo_atual;
+                        Modulo *mod_anterior = &g->modulos[anterior];
+                        if (q->estado[anterior] == MOD_EM_EXECUCAO) {
+                            mudar_estado_modulo(g, anterior, MOD_PENDENTE);
+                            mod_anterior->instrucao_digitada[0] = '\0';
+                        }
+                    }
+                }
+                
+                mudar_estado_modulo(g, modulo_idx, MOD_EM_EXECUCAO);
+                t->modulo_atual = modulo_idx;
+                utilizacao_modulo_atribuido(g, modulo_idx);
+                
+                // Bancada escolhida ocupada: espera na fila dela; sem escolha: fila global
+                if (bancada_idx >= 0) {
+                    if (!bancada_ocupar(g, bancada_idx, tedax_idx)) {
+                        bancada_entrar_espera(g, bancada_idx, tedax_idx);
+                    }
+                } else if (bancada_ocupar_qualquer(g, tedax_idx) < 0) {
+                    bancada_entrar_espera(g, -1, tedax_idx);
+                }
+                repor_modulo_se_necessario(g);
+            }
+            
+            return 1;
+        } else {
+            strncpy(g->mensagem_erro, "Entrada Invalida", 63);
+            g->mensagem_erro[63] = '\0';
+            return 0;
+        }
+    }
+    else {
+        strncpy(g->mensagem_erro, "Entrada Invalida", 63);
+        g->mensagem_erro[63] = '\0';
+        return 0;
+    }
+}
+
+int executar_comando(GameState *g, const char *buffer) {
+    int aceito = aplicar_comando(g, buffer);
+    registrar_evento(aceito ? EVENTO_COMANDO_ACEITO : EVENTO_COMANDO_REJEITADO, g->semente,
+                     -1, -1, -1, 0, buffer);
+    if (aceito) {
+        painel_publicar(g);
+    }
+    return aceito;
+}
+
 void* thread_coordenador(void* arg) {
     GameState *g = (GameState*)arg;
     extern char buffer_instrucao_global[64];
     int buffer_len = 0;
     
+    // Medição de latência: última consulta ao teclado e esperas por mutex_jogo
+    struct timespec consulta_anterior, antes_consulta, lida;
+    clock_gettime(CLOCK_MONOTONIC, &consulta_anterior);
+    
     while (g->jogo_rodando && !g->jogo_terminou) {
+        // getch (não bloqueante) também mexe na tela: serializado com desenhar_tela pelo mutex
+        clock_gettime(CLOCK_MONOTONIC, &antes_consulta);
+        pthread_mutex_lock(&g->mutex_jogo);
+        clock_gettime(CLOCK_MONOTONIC, &lida);
         int ch = getch();
+        pthread_mutex_unlock(&g->mutex_jogo);
+        double espera_trava_ms = ms_entre(&antes_consulta, &lida);
         
-        if (ch == ERR) {
-        } else if (ch == 'q' || ch == 'Q') {
+        if (ch == 'q' || ch == 'Q') {
             pthread_mutex_lock(&g->mutex_jogo);
-            g->jogo_rodando = 0;
+            encerrar_partida(g, 0);
             pthread_mutex_unlock(&g->mutex_jogo);
             break;
-        } else {
+        } else if (ch == KEY_RESIZE) {
+            // SIGWINCH: o ncurses já atualizou LINES/COLS; a janela do mural segue no próximo quadro
             pthread_mutex_lock(&g->mutex_jogo);
+            redimensionar_tela_partida();
+            pthread_mutex_unlock(&g->mutex_jogo);
+        } else if (ch == KEY_F(5)) {
+            // Salvar: só a serialização acontece com o mutex travado; o arquivo é gravado depois
+            static unsigned char retrato[TAMANHO_MAX_SALVAMENTO];
+            struct timespec inicio, fim;
+            clock_gettime(CLOCK_MONOTONIC, &inicio);
+            pthread_mutex_lock(&g->mutex_jogo);
+            size_t tamanho = serializar_partida(g, retrato, sizeof(retrato));
+            pthread_mutex_unlock(&g->mutex_jogo);
+            clock_gettime(CLOCK_MONOTONIC, &fim);
+            long micros = (long)(ms_entre(&inicio, &fim) * 1000.0);
+            
+            int ok = tamanho > 0 && gravar_arquivo_partida(ARQUIVO_SALVAMENTO, retrato, tamanho);
+            pthread_mutex_lock(&g->mutex_jogo);
+            if (ok) {
+                snprintf(g->mensagem_erro, sizeof(g->mensagem_erro), "Partida salva em %s (%zu bytes, %ld us)",
+                         ARQUIVO_SALVAMENTO, tamanho, micros);
+            } else {
+                snprintf(g->mensagem_erro, sizeof(g->mensagem_erro), "Falha ao salvar a partida");
+            }
+            pthread_mutex_unlock(&g->mutex_jogo);
+        } else if (ch != ERR) {
+            struct timespec antes_trava, com_trava;
+            clock_gettime(CLOCK_MONOTONIC, &antes_trava);
+            pthread_mutex_lock(&g->mutex_jogo);
+            clock_gettime(CLOCK_MONOTONIC, &com_trava);
+            espera_trava_ms += ms_entre(&antes_trava, &com_trava);
             
             if (ch == KEY_BACKSPACE || ch == 127 || ch == '\b') {
                 if (buffer_len > 0) {
@@ -625,172 +1040,16 @@ void* thread_coordenador(void* arg) {
                     buffer_instrucao_global[buffer_len] = '\0';
                 }
             }
+            else if (ch == KEY_UP || ch == KEY_DOWN) {
+                rolar_mural(ch == KEY_UP ? -1 : 1, 0);
+            }
+            else if (ch == KEY_PPAGE || ch == KEY_NPAGE) {
+                rolar_mural(0, ch == KEY_PPAGE ? -1 : 1);
+            }
             else if (ch == '\n' || ch == '\r') {
-                g->mensagem_erro[0] = '\0';
-                
-                int tedax_idx = -1, bancada_idx = -1, modulo_idx = -1;
-                char instrucao[16] = "";
-                
-                if (processar_comando(buffer_instrucao_global, g, &tedax_idx, &bancada_idx, &modulo_idx, instrucao)) {
-                    // Aplica regras de default para valores não especificados
-                    if (tedax_idx == -1) {
-                        for (int i = 0; i < g->qtd_tedax; i++) {
-                            if (g->tedax[i].estado == TEDAX_LIVRE) {
-                                tedax_idx = i;
-                                break;
-                            }
-                        }
-                    }
-                    
-                    if (bancada_idx == -1) {
-                        for (int i = 0; i < g->qtd_bancadas; i++) {
-                            if (g->bancadas[i].estado == BANCADA_LIVRE) {
-                                bancada_idx = i;
-                                break;
-                            }
-                        }
-                        if (bancada_idx == -1 && g->qtd_bancadas > 0) {
-                            bancada_idx = 0;
-                        }
-                    }
-                    
-                    if (modulo_idx == -1) {
-                        for (int i = 0; i < g->qtd_modulos; i++) {
-                            if (g->modulos[i].estado == MOD_PENDENTE) {
-                                modulo_idx = i;
-                                break;
-                            }
-                        }
-                    }
-                    
-                    int valido = 1;
-                    
-                    if (tedax_idx < 0 || tedax_idx >= g->qtd_tedax) {
-                        valido = 0;
-                    }
-                    
-                    if (bancada_idx < 0 || bancada_idx >= g->qtd_bancadas) {
-                        valido = 0;
-                    }
-                    
-                    if (modulo_idx < 0 || modulo_idx >= g->qtd_modulos) {
-                        valido = 0;
-                    } else if (g->modulos[modulo_idx].estado != MOD_PENDENTE) {
-                        valido = 0;
-                        if (g->modulos[modulo_idx].estado == MOD_RESOLVIDO) {
-                            valido = 0;
-                        }
-                    }
-                    
-                    if (valido && strlen(instrucao) > 0) {
-                        Modulo *mod = &g->modulos[modulo_idx];
-                        Tedax *t = &g->tedax[tedax_idx];
-                        
-                        strncpy(mod->instrucao_digitada, instrucao, 15);
-                        mod->instrucao_digitada[15] = '\0';
-                        
-                        if (t->estado == TEDAX_OCUPADO) {
-                            // Adiciona à fila (máximo 1)
-                            if (t->qtd_fila > 0) {
-                                strncpy(g->mensagem_erro, "Tedax ja tem modulo em espera", 63);
-                                g->mensagem_erro[63] = '\0';
-                            } else {
-                                t->fila_modulos[0] = modulo_idx;
-                                t->qtd_fila = 1;
-                                mod->estado = MOD_PENDENTE;
-                                mod->tempo_restante = mod->tempo_total;
-                            }
-                        } else {
-                            // Limpa espera anterior se tedax estava esperando
-                            if (t->estado == TEDAX_ESPERANDO && t->bancada_atual >= 0) {
-                                if (g->bancadas[t->bancada_atual].tedax_esperando == t->id) {
-                                    g->bancadas[t->bancada_atual].tedax_esperando = -1;
-                                }
-                                
-                                if (t->modulo_atual >= 0 && t->modulo_atual < g->qtd_modulos) {
-                                    Modulo *mod_anterior = &g->modulos[t->modulo_atual];
-                                    if (mod_anterior->estado == MOD_EM_EXECUCAO) {
-                                        mod_anterior->estado = MOD_PENDENTE;
-                                        mod_anterior->tempo_restante = mod_anterior->tempo_total;
-                                        mod_anterior->instrucao_digitada[0] = '\0';
-                                        mod_anterior->tempo_desde_resolvido = -1;
-                                    }
-                                }
-                            }
-                            
-                            mod->estado = MOD_EM_EXECUCAO;
-                            mod->tempo_restante = mod->tempo_total;
-                            
-                            if (g->bancadas[bancada_idx].estado == BANCADA_LIVRE) {
-                                t->estado = TEDAX_OCUPADO;
-                                t->modulo_atual = modulo_idx;
-                                t->bancada_atual = bancada_idx;
-                                
-                                g->bancadas[bancada_idx].estado = BANCADA_OCUPADA;
-                                g->bancadas[bancada_idx].tedax_ocupando = t->id;
-                                g->bancadas[bancada_idx].tedax_esperando = -1;
-                            } else {
-                                // Bancada ocupada: procura outra livre ou entra em espera
-                                if (g->bancadas[bancada_idx].tedax_esperando >= 0) {
-                                    int bancada_encontrada = 0;
-                                    for (int i = 0; i < g->qtd_bancadas; i++) {
-                                        if (g->bancadas[i].estado == BANCADA_LIVRE && 
-                                            g->bancadas[i].tedax_esperando < 0) {
-                                            t->estado = TEDAX_OCUPADO;
-                                            t->modulo_atual = modulo_idx;
-                                            t->bancada_atual = i;
-                                            g->bancadas[i].estado = BANCADA_OCUPADA;
-                                            g->bancadas[i].tedax_ocupando = t->id;
-                                            g->bancadas[i].tedax_esperando = -1;
-                                            bancada_encontrada = 1;
-                                            break;
-                                        }
-                                    }
-                                    
-                                    if (!bancada_encontrada) {
-                                        int bancada_espera = -1;
-                                        for (int i = 0; i < g->qtd_bancadas; i++) {
-                                            if (g->bancadas[i].tedax_esperando < 0) {
-                                                bancada_espera = i;
-                                                break;
-                                            }
-                                        }
-                                        
-                                        if (bancada_espera >= 0) {
-                                            t->estado = TEDAX_ESPERANDO;
-                                            t->modulo_atual = modulo_idx;
-                                            t->bancada_atual = bancada_espera;
-                                            g->bancadas[bancada_espera].tedax_esperando = t->id;
-                                        } else {
-                                            t->estado = TEDAX_ESPERANDO;
-                                            t->modulo_atual = modulo_idx;
-                                            t->bancada_atual = bancada_idx;
-                                        }
-                                    }
-                                } else {
-                                    t->estado = TEDAX_ESPERANDO;
-                                    t->modulo_atual = modulo_idx;
-                                    t->bancada_atual = bancada_idx;
-                                    g->bancadas[bancada_idx].tedax_esperando = t->id;
-                                }
-                            }
-                        }
-                        
-                        buffer_len = 0;
-                        buffer_instrucao_global[0] = '\0';
-                    } else {
-                        strncpy(g->mensagem_erro, "Entrada Invalida", 63);
-                        g->mensagem_erro[63] = '\0';
-                        buffer_len = 0;
-                        buffer_instrucao_global[0] = '\0';
-                    }
-                }
-                else {
-                    strncpy(g->mensagem_erro, "Entrada Invalida", 63);
-                    g->mensagem_erro[63] = '\0';
-                    buffer_len = 0;
-                    buffer_instrucao_global[0] = '\0';
-                }
+                executar_comando(g, buffer_instrucao_global);
+                buffer_len = 0;
+                buffer_instrucao_global[0] = '\0';
             }
             else if (ch >= 32 && ch <= 126) {
                 if (buffer_len < 63) {
@@ -800,13 +1059,13 @@ void* thread_coordenador(void* arg) {
                 }
             }
             
+            // Entrada termina ao pedir a trava: a espera por ela já está em espera_trava_ms
+            latencia_tecla_aplicada(&consulta_anterior, &antes_consulta, espera_trava_ms);
             pthread_mutex_unlock(&g->mutex_jogo);
         }
+        consulta_anterior = lida;
         
-        struct timespec ts;
-        ts.tv_sec = 0;
-        ts.tv_nsec = 50000000L;
-        nanosleep(&ts, NULL);
+        dormir_partida(g, 50000000L);
     }
     
     return NULL;
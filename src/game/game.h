@@ -3,6 +3,22 @@
 
 #include <pthread.h>
 #include <semaphore.h>
+#include <stdatomic.h>
+#include <time.h>
+#include "../temporizador/temporizador.h"
+
+#define MAX_TEDAX 5
+#define MAX_BANCADAS 5
+#define MAX_FILA_TEDAX 8
+#define MAX_MODULOS 100
+
+// Todos os prazos da partida vivem na roda de temporizadores (1 tick = 0.2s)
+#define TICKS_POR_SEGUNDO 5
+#define SEGUNDOS_RESOLVIDO_VISIVEL 20
+#define TEMPORIZADOR_RELOGIO 0                                  // Segundo da partida (fim do tempo)
+#define TEMPORIZADOR_GERACAO 1                                  // Próximo módulo do mural
+#define TEMPORIZADOR_TEDAX(i) (2 + (i))                         // Conclusão do módulo do tedax i
+#define TEMPORIZADOR_RESOLVIDO(m) (2 + MAX_TEDAX + (m))         // Módulo m sai do mural
 
 typedef enum {
     MOD_PENDENTE,
@@ -45,9 +61,18 @@ typedef enum {
 typedef enum {
     DIFICULDADE_FACIL,
     DIFICULDADE_MEDIO,
-    DIFICULDADE_DIFICIL
+    DIFICULDADE_DIFICIL,
+    DIFICULDADE_CUSTOM
 } Dificuldade;
 
+// Ordem em que módulos pendentes, itens da fila do tedax e tedax à espera de bancada são
+// atendidos (src/escalonamento); empates sempre pela ordem de chegada
+typedef enum {
+    POLITICA_FIFO,              // Ordem de chegada
+    POLITICA_SJF,               // Menor tempo_total primeiro
+    POLITICA_EDF                // Menor prazo primeiro (criado_em + tempo_total)
+} PoliticaEscalonamento;
+
 typedef struct {
     CorBotao cor;
 } DadosBotao;
@@ -55,7 +80,6 @@ typedef struct {
 typedef struct {
     char hash[32];
     char senha_correta[16];
-    char mapeamento[256];
 } DadosSenha;
 
 typedef struct {
@@ -70,20 +94,62 @@ typedef union {
     DadosFios fios;
 } DadosModulo;
 
+// Parte fria do módulo: lida ao gerar, validar e desenhar o próprio módulo.
+// Estado e id ficam em ModulosQuentes, no mesmo índice; os prazos, na roda.
 typedef struct {
-    int id;
     TipoModulo tipo;
     int tempo_total;
-    int tempo_restante;
-    EstadoModulo estado;
+    int criado_em;              // Segundo da partida em que apareceu no mural
+    int tempo_solucao;          // Segundos do mural até resolvido (-1 = não resolvido)
+    int atribuido_no_tick;      // Tick do comando aceito, até o início na bancada (-1 = nenhum)
+    int espera_inicio;          // Ticks da última atribuição ao início na bancada (-1 = não começou)
     
     DadosModulo dados;
     char instrucao_correta[32];
     char instrucao_digitada[32];
-    
-    int tempo_desde_resolvido;
 } Modulo;
 
+// Campos percorridos por todos os módulos, em vetores paralelos: contar resolvidos
+// ou procurar pendentes lê só algumas linhas de cache contíguas em vez de saltar
+// de um Modulo inteiro para o próximo.
+typedef struct {
+    int id[MAX_MODULOS];
+    unsigned char estado[MAX_MODULOS];          // EstadoModulo
+    unsigned char reservado[MAX_MODULOS];       // Já está na fila de algum tedax
+} ModulosQuentes;
+
+#define TAMANHO_ESTOQUE_MODULOS 8
+
+// Módulo sorteado com antecedência, com o estado do gerador logo depois dele
+typedef struct {
+    Modulo modulo;
+    unsigned int estado_rng_depois;
+    int tempo_minimo_execucao;          // Configuração usada no sorteio (se mudou, é descartado)
+    int tempo_variacao_execucao;
+    Dificuldade dificuldade_modulos;
+} ModuloPronto;
+
+// Estoque de módulos prontos: thread_estoque sorteia fora de mutex_jogo e publicar um
+// módulo no mural vira uma retirada O(1). Os módulos saem na ordem em que o gerador da
+// partida os sortearia, então a semente continua reproduzindo a partida. Trava própria,
+// sempre tomada depois de mutex_jogo (ou sozinha, pela thread_estoque).
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond_espaco;
+    ModuloPronto itens[TAMANHO_ESTOQUE_MODULOS];
+    int inicio;
+    int qtd;
+    unsigned int estado_rng;    // Gerador depois do último módulo publicado ou em estoque
+    unsigned int versao;        // Muda a cada descarte: sorteio em andamento não entra
+    Dificuldade dificuldade;
+    int ativo;                  // 0 = thread_estoque deve sair
+} EstoqueModulos;
+
+typedef struct {
+    int modulo_idx;
+    int bancada_idx;            // -1 = qualquer bancada
+} ItemFilaTedax;
+
 typedef struct {
     int id;
     EstadoTedax estado;
@@ -91,61 +157,137 @@ typedef struct {
     int bancada_atual;
     pthread_t thread_id;
     
-    int fila_modulos[1];
+    // Fila circular de trabalho (capacidade definida pela fase)
+    ItemFilaTedax fila[MAX_FILA_TEDAX];
+    int inicio_fila;
     int qtd_fila;
+    int capacidade_fila;
+    pthread_cond_t cond_trabalho;
+    int prazo_vencido;          // Módulo atual chegou ao fim do tempo (thread do tedax conclui)
 } Tedax;
 
+// Fila FIFO circular de tedax em espera (ids), com ticket de chegada para desempate justo
+typedef struct {
+    int tedax_ids[MAX_TEDAX];
+    unsigned int tickets[MAX_TEDAX];
+    int inicio;
+    int qtd;
+} FilaEspera;
+
 typedef struct {
     int id;
     EstadoBancada estado;
     int tedax_ocupando;
-    int tedax_esperando;
+    FilaEspera espera;
 } Bancada;
 
+// Tempo de cada recurso na partida, em ticks, somado a cada avancar_tick_partida
+// (src/utilizacao): estados dos tedax, bancadas ocupadas e esperas dos módulos
+typedef struct {
+    long ticks;
+    long ticks_tedax[MAX_TEDAX][3];         // Por EstadoTedax
+    long ticks_bancada_ocupada[MAX_BANCADAS];
+    long ticks_algum_esperando;             // Algum tedax esperando bancada
+    long ticks_pendente_sem_tedax;          // Módulo sem dono no mural e todos os tedax nas bancadas
+    long esperas;                           // Atribuições que chegaram à bancada
+    long soma_espera;                       // Ticks da atribuição ao início, somados
+    int max_espera;
+} UtilizacaoPartida;
+
 typedef struct {
     Dificuldade dificuldade;
     int tempo_total_partida;
     int tempo_restante;
     
-    Modulo modulos[100];
+    ModulosQuentes quente;
+    Modulo modulos[MAX_MODULOS];
     int qtd_modulos;
     int proximo_id_modulo;
     int modulos_necessarios;
+    unsigned int versao_mural;  // Muda quando um módulo entra, muda de estado ou sai do mural (ui refaz a lista)
+    int pendentes_livres;       // Módulos MOD_PENDENTE sem reserva em fila de tedax (evita varrer o mural por tick)
     
-    Tedax tedax[5];
-    Bancada bancadas[5];
+    Tedax tedax[MAX_TEDAX];
+    Bancada bancadas[MAX_BANCADAS];
     int qtd_tedax;
     int qtd_bancadas;
     
-    int ticks_desde_ultimo_modulo;
+    unsigned int bancadas_livres;   // Bit i = bancada i livre
+    FilaEspera espera_global;       // Tedax aguardando qualquer bancada
+    unsigned int proximo_ticket_espera;
+    PoliticaEscalonamento politica;     // Escolhida por partida (TEDAX_ESCALONAMENTO)
+    
+    unsigned int semente;       // Semente da partida (reproduz a mesma sequência de módulos)
+    unsigned int estado_rng;    // Gerador próprio da partida (xorshift32), usado com mutex_jogo
+    EstoqueModulos estoque;     // Próximos módulos já sorteados (thread_estoque)
+    
+    RodaTemporizadores roda;    // Avançada só por avancar_tick_partida
+    int threads_da_partida;     // 1: mural e tedax têm threads próprias; 0: tudo roda no tick
+    int geracao_pendente;       // Prazo do mural venceu (thread_mural gera)
     int intervalo_geracao;
     int max_modulos;
     
-    int jogo_rodando;
-    int jogo_terminou;
+    // Lidas sem trava nas condições dos laços; só encerrar_partida as zera/liga durante o jogo
+    atomic_int jogo_rodando;
+    atomic_int jogo_terminou;
+    struct timespec instante_encerramento;     // CLOCK_MONOTONIC de encerrar_partida
     
     pthread_mutex_t mutex_jogo;
     pthread_cond_t cond_modulo_disponivel;
     pthread_cond_t cond_bancada_disponivel;
     pthread_cond_t cond_tela_atualizada;
+    pthread_cond_t cond_mural;
+    
+    // Pausas entre quadros e ticks (dormir_partida): encerrar_partida as interrompe
+    pthread_mutex_t mutex_despertar;
+    pthread_cond_t cond_despertar;
     
     char mensagem_erro[64];
     int erros_cometidos;
+    UtilizacaoPartida uso;
 } GameState;
 
+// Argumento de thread_tedax; pertence a quem cria a thread e vive até o join
+typedef struct {
+    GameState *g;
+    int tedax_id;
+} TedaxArgs;
+
+// inicializar = criar_sincronizacao + reiniciar; finalizar = terminar + destruir_sincronizacao.
+// Quem reaproveita o GameState (src/ciclo) só reinicia e termina entre uma partida e outra
 void inicializar_jogo(GameState *g, Dificuldade dificuldade, int num_tedax, int num_bancadas);
 void finalizar_jogo(GameState *g);
+void criar_sincronizacao_jogo(GameState *g);
+void destruir_sincronizacao_jogo(GameState *g);
+void reiniciar_jogo(GameState *g, Dificuldade dificuldade, int num_tedax, int num_bancadas);
+// Mesma partida nova, com semente dada (a mesma semente gera os mesmos módulos)
+void reiniciar_jogo_semente(GameState *g, Dificuldade dificuldade, int num_tedax, int num_bancadas,
+                            unsigned int semente);
+void terminar_jogo(GameState *g);
+void encerrar_partida(GameState *g, int terminou);
+int dormir_partida(GameState *g, long nanos);
 void gerar_novo_modulo(GameState *g);
+void descartar_estoque_modulos(GameState *g);
+void parar_estoque_modulos(GameState *g);
+int sortear(unsigned int *estado_rng, int limite);
+int avancar_tick_partida(GameState *g);
+void iniciar_contagem_modulo(GameState *g, int tedax_idx);
+int tempo_restante_modulo(const GameState *g, int modulo_idx);
+int segundos_desde_resolvido(const GameState *g, int modulo_idx);
+int executar_comando(GameState *g, const char *buffer);
 
 int todos_modulos_resolvidos(const GameState *g);
 int contar_modulos_resolvidos(const GameState *g);
 int tem_modulos_pendentes(const GameState *g);
+void recontar_pendentes_livres(GameState *g);
 
 const char* nome_cor(CorBotao cor);
 const char* nome_estado_modulo(EstadoModulo estado);
+const char* nome_estado_tedax(EstadoTedax estado);
 const char* nome_dificuldade(Dificuldade dificuldade);
 
 void* thread_mural(void* arg);
+void* thread_estoque(void* arg);
 void* thread_exibicao(void* arg);
 void* thread_tedax(void* arg);
 void* thread_coordenador(void* arg);
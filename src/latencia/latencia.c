@@ -0,0 +1,128 @@
+#define _POSIX_C_SOURCE 200809L
+#include "latencia.h"
+#include "../comum/comum.h"
+#include <stdlib.h>
+#include <string.h>
+
+enum { PARTE_TOTAL, PARTE_ENTRADA, PARTE_TRAVAS, PARTE_QUADRO, QTD_PARTES };
+
+static const char *nomes_partes[QTD_PARTES] = { "total", "entrada", "travas", "quadro" };
+
+// Tecla aplicada ao comando e ainda não mostrada
+typedef struct {
+    struct timespec aplicada;
+    float entrada_ms;
+    float trava_ms;
+} TeclaPendente;
+
+typedef struct {
+    int teclas;
+    float p50[QTD_PARTES];
+    float p90[QTD_PARTES];
+    float p99[QTD_PARTES];
+    float max[QTD_PARTES];
+} ResumoLatencia;
+
+static TeclaPendente pendentes[MAX_TECLAS_SEM_QUADRO];
+static int qtd_pendentes = 0;
+
+static float amostras[QTD_PARTES][MAX_AMOSTRAS_LATENCIA];
+static int qtd_amostras = 0;
+
+static ResumoLatencia resumos[MAX_PARTIDAS_LATENCIA];
+static int qtd_resumos = 0;
+static int partidas_sem_resumo = 0;
+
+void latencia_iniciar_partida(void) {
+    qtd_pendentes = 0;
+    qtd_amostras = 0;
+}
+
+void latencia_tecla_aplicada(const struct timespec *consulta_anterior, const struct timespec *pedido,
+                             double espera_trava_ms) {
+    if (qtd_pendentes >= MAX_TECLAS_SEM_QUADRO) {
+        return;
+    }
+    TeclaPendente *p = &pendentes[qtd_pendentes++];
+    clock_gettime(CLOCK_MONOTONIC, &p->aplicada);
+    p->entrada_ms = (float)ms_entre(consulta_anterior, pedido);
+    p->trava_ms = (float)espera_trava_ms;
+}
+
+void latencia_quadro_apresentado(const struct timespec *antes_trava, const struct timespec *com_trava) {
+    struct timespec agora;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    double espera_exibicao = ms_entre(antes_trava, com_trava);
+
+    for (int i = 0; i < qtd_pendentes && qtd_amostras < MAX_AMOSTRAS_LATENCIA; i++) {
+        const TeclaPendente *p = &pendentes[i];
+        // A exibição só atrasou a tecla pelo tempo que esperou depois de ela ser aplicada
+        double atraso_trava = ms_entre(&p->aplicada, com_trava);
+        if (atraso_trava > espera_exibicao) {
+            atraso_trava = espera_exibicao;
+        }
+        double travas = p->trava_ms + atraso_trava;
+        double desde_aplicada = ms_entre(&p->aplicada, &agora);
+        double total = p->entrada_ms + p->trava_ms + desde_aplicada;
+
+        amostras[PARTE_TOTAL][qtd_amostras] = (float)total;
+        amostras[PARTE_ENTRADA][qtd_amostras] = p->entrada_ms;
+        amostras[PARTE_TRAVAS][qtd_amostras] = (float)travas;
+        amostras[PARTE_QUADRO][qtd_amostras] = (float)(desde_aplicada - atraso_trava);
+        qtd_amostras++;
+    }
+    qtd_pendentes = 0;
+}
+
+static int comparar_float(const void *a, const void *b) {
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+// Percentil pelo posto mais próximo sobre amostras ordenadas
+static float percentil(const float *ordenadas, int n, int p) {
+    int posto = (p * n + 99) / 100;
+    if (posto < 1) posto = 1;
+    return ordenadas[posto - 1];
+}
+
+void latencia_encerrar_partida(void) {
+    if (qtd_resumos >= MAX_PARTIDAS_LATENCIA) {
+        partidas_sem_resumo++;
+        return;
+    }
+    ResumoLatencia *r = &resumos[qtd_resumos++];
+    memset(r, 0, sizeof(*r));
+    r->teclas = qtd_amostras;
+    for (int k = 0; k < QTD_PARTES && qtd_amostras > 0; k++) {
+        qsort(amostras[k], (size_t)qtd_amostras, sizeof(float), comparar_float);
+        r->p50[k] = percentil(amostras[k], qtd_amostras, 50);
+        r->p90[k] = percentil(amostras[k], qtd_amostras, 90);
+        r->p99[k] = percentil(amostras[k], qtd_amostras, 99);
+        r->max[k] = amostras[k][qtd_amostras - 1];
+    }
+    qtd_pendentes = 0;
+    qtd_amostras = 0;
+}
+
+void latencia_imprimir_resumos(FILE *saida) {
+    if (qtd_resumos > 0) {
+        fprintf(saida, "Latencia tecla->tela (limite superior: a entrada conta o intervalo inteiro desde a "
+                       "consulta anterior ao teclado, nao a chegada da tecla)\n");
+    }
+    for (int i = 0; i < qtd_resumos; i++) {
+        const ResumoLatencia *r = &resumos[i];
+        fprintf(saida, "  partida %d: %d tecla(s)\n", i + 1, r->teclas);
+        if (r->teclas == 0) {
+            continue;
+        }
+        fprintf(saida, "  %-8s %8s %8s %8s %8s (ms)\n", "", "p50", "p90", "p99", "max");
+        for (int k = 0; k < QTD_PARTES; k++) {
+            fprintf(saida, "  %-8s %8.1f %8.1f %8.1f %8.1f\n", nomes_partes[k],
+                    r->p50[k], r->p90[k], r->p99[k], r->max[k]);
+        }
+    }
+    if (partidas_sem_resumo > 0) {
+        fprintf(saida, "  (%d partida(s) sem resumo de latencia)\n", partidas_sem_resumo);
+    }
+}
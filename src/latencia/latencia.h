@@ -0,0 +1,36 @@
+#ifndef LATENCIA_H
+#define LATENCIA_H
+
+#include <stdio.h>
+#include <time.h>
+
+// Latência tecla -> tela da partida: thread_coordenador marca cada tecla aplicada ao
+// comando e thread_exibicao marca o quadro que a mostrou, já escrito no terminal.
+// Cada amostra é dividida em:
+//   entrada - da consulta anterior ao getch até a próxima consulta: o intervalo inteiro,
+//             porque a chegada da tecla não é marcada. É o pior caso (tecla chegada logo
+//             depois da consulta anterior), então total e entrada são limites superiores
+//   travas  - espera por mutex_jogo no coordenador (getch e aplicação) e na exibição
+//   quadro  - o resto: espera pelo próximo quadro de 0.2s e o desenho em si
+// Todas as funções, exceto imprimir, são chamadas com mutex_jogo travado.
+
+#define MAX_AMOSTRAS_LATENCIA 4096
+#define MAX_TECLAS_SEM_QUADRO 256
+#define MAX_PARTIDAS_LATENCIA 32
+
+void latencia_iniciar_partida(void);
+
+// Tecla consultada a partir de `pedido` (quando o coordenador pediu mutex_jogo para o getch),
+// com a consulta anterior ao teclado em `consulta_anterior`; `espera_trava_ms` soma as
+// esperas do coordenador por mutex_jogo para esta tecla, fora do trecho de entrada
+void latencia_tecla_aplicada(const struct timespec *consulta_anterior, const struct timespec *pedido,
+                             double espera_trava_ms);
+
+// Quadro desenhado e escrito; a exibição pediu mutex_jogo em `antes_trava` e o obteve em `com_trava`
+void latencia_quadro_apresentado(const struct timespec *antes_trava, const struct timespec *com_trava);
+
+// Fecha as amostras da partida num resumo de percentis
+void latencia_encerrar_partida(void);
+void latencia_imprimir_resumos(FILE *saida);
+
+#endif // LATENCIA_H
@@ -10,240 +10,397 @@
 #include "../ui/ui.h"
 #include "../audio/audio.h"
 #include "../fases/fases.h"
+#include "../protocolo/protocolo.h"
+#include "../servidor/servidor.h"
+#include "../espectador/espectador.h"
+#include "../salvamento/salvamento.h"
+#include "../placar/placar.h"
+#include "../latencia/latencia.h"
+#include "../eventos/eventos.h"
+#include "../extras/extras.h"
+#include "../ciclo/ciclo.h"
+#include "../escalonamento/escalonamento.h"
+#include "../painel/painel.h"
 
 // Buffer de instrução global (compartilhado entre threads)
 // Suporta comandos do formato T1B1M1:ppp
 char buffer_instrucao_global[64] = "";
 int audio_disponivel_global = 0;
 
-int main(void) {
-    // Inicializar áudio (Música começa desligada)
-    audio_disponivel_global = inicializar_audio();
+typedef struct {
+    int vitoria;
+    int tempo_restante;
+    int erros;
+    int placar_gravado;
+    ResumoPlacar placar;
+    int tem_utilizacao;
+    ResumoUtilizacao utilizacao;
+} ResultadoPartida;
+
+// Estado TELA_PARTIDA: roda uma partida completa no GameState e nas threads do ciclo
+// (src/ciclo), que voltam a estacionar no fim. Retorna a próxima tela: pós-jogo, ou menu
+// se nenhum módulo chegou a ser gerado.
+static Tela jogar_partida(Dificuldade dificuldade, int num_tedax, int num_bancadas,
+                          const unsigned char *partida_salva, size_t tamanho_salva, ResultadoPartida *resultado) {
+    // Parar música do menu e tocar música da fase baseada na dificuldade
+    parar_musica();
+    definir_dificuldade_musica(dificuldade == DIFICULDADE_MEDIO);
+    
+    const char* musica_fase = NULL;
+    switch (dificuldade) {
+        case DIFICULDADE_FACIL:
+            musica_fase = "sounds/Fase_1.mp3";
+            break;
+        case DIFICULDADE_MEDIO:
+            musica_fase = "sounds/Fase_2.mp3";
+            break;
+        case DIFICULDADE_DIFICIL:
+            musica_fase = "sounds/Fase_3.mp3";
+            break;
+        case DIFICULDADE_CUSTOM:
+            musica_fase = "sounds/Fase_2.mp3";
+            break;
+    }
+    if (musica_fase && audio_disponivel_global) {
+        tocar_musica(musica_fase);
+    }
     
-    GameState g;
-    
-    while (1) {
-        inicializar_ncurses();
-        if (has_colors()) {
-            start_color();
-            init_pair(1, COLOR_CYAN, COLOR_BLACK);
-            init_pair(2, COLOR_GREEN, COLOR_BLACK);
-            init_pair(3, COLOR_YELLOW, COLOR_BLACK);
-            init_pair(4, COLOR_RED, COLOR_BLACK);
-            init_pair(5, COLOR_BLUE, COLOR_BLACK);
-            init_pair(6, COLOR_WHITE, COLOR_BLACK);
-            init_pair(7, COLOR_BLACK, COLOR_WHITE);
+    GameState *g = ciclo_nova_partida(dificuldade, num_tedax, num_bancadas);
+    utilizacao_gravar_serie(g);
+    if (partida_salva) {
+        // Retrato aplicado antes de soltar as threads: elas já partem do estado salvo
+        pthread_mutex_lock(&g->mutex_jogo);
+        if (!restaurar_partida(g, partida_salva, tamanho_salva)) {
+            snprintf(g->mensagem_erro, sizeof(g->mensagem_erro), "%s", erro_salvamento());
         }
-        
-        int modo_escolhido = mostrar_menu_principal();
-        if (modo_escolhido == -1) {
-            finalizar_ncurses();
-            printf("Jogo encerrado.\n");
-            return 0;
+        pthread_mutex_unlock(&g->mutex_jogo);
+    }
+    transmissao_definir_partida(g);
+    painel_definir_partida(g);
+    buffer_instrucao_global[0] = '\0';
+    
+    // Durante a partida o coordenador consulta o teclado sem bloquear
+    iniciar_tela_partida();
+    definir_entrada_bloqueante(0);
+    latencia_iniciar_partida();
+    
+    // Mural, estoque, exibição, coordenador e tedax: já existem, estacionados desde a última partida
+    ciclo_soltar_threads();
+    
+    // Thread principal: avança a roda de temporizadores (relógio, geração, módulos) a cada
+    // tick de 0.2s; o fim da partida, venha de onde vier, interrompe a pausa
+    while (dormir_partida(g, 200000000L)) {
+        pthread_mutex_lock(&g->mutex_jogo);
+        int terminou = avancar_tick_partida(g);
+        pthread_mutex_unlock(&g->mutex_jogo);
+        if (terminou) {
+            break;
         }
-        
-        // Se escolheu Classico, mostrar menu de dificuldades do modo classico
-        if (modo_escolhido == 0) {
-            int dificuldade_menu = mostrar_menu_dificuldades();
-            if (dificuldade_menu == -1) {
-                finalizar_ncurses();
-                continue;
-            }
-            
-            Dificuldade dificuldade_escolhida;
-            switch (dificuldade_menu) {
-                case 0: // Fácil
-                    dificuldade_escolhida = DIFICULDADE_FACIL;
-                    break;
-                case 1: // Médio
-                    dificuldade_escolhida = DIFICULDADE_MEDIO;
-                    break;
-                case 2: // Difícil
-                    dificuldade_escolhida = DIFICULDADE_DIFICIL;
-                    break;
-                default:
-                    dificuldade_escolhida = DIFICULDADE_FACIL;
-                    break;
-            }
+    }
     
-            const ConfigFase *config = obter_config_fase(dificuldade_escolhida);
-            int num_tedax = config->num_tedax;
-            int num_bancadas = config->num_bancadas;
-            
-            // Finalizar ncurses temporário (será reinicializado nas threads)
-            finalizar_ncurses();
-            // Parar música do menu e tocar música da fase baseada na dificuldade
-            parar_musica();
-            definir_dificuldade_musica(dificuldade_escolhida == DIFICULDADE_MEDIO);
-            
-            const char* musica_fase = NULL;
-            switch (dificuldade_escolhida) {
-                case DIFICULDADE_FACIL:
-                    musica_fase = "sounds/Fase_1.mp3";
-                    break;
-                case DIFICULDADE_MEDIO:
-                    musica_fase = "sounds/Fase_2.mp3";
-                    break;
-                case DIFICULDADE_DIFICIL:
-                    musica_fase = "sounds/Fase_3.mp3";
-                    break;
-            }
-            if (musica_fase && audio_disponivel_global) {
-                tocar_musica(musica_fase);
-            }
-            
-            inicializar_jogo(&g, dificuldade_escolhida, num_tedax, num_bancadas);
-    
-    // Criar threads
-    pthread_t thread_mural_id;
-    pthread_t thread_exibicao_id;
-    pthread_t thread_tedax_ids[5];
-    pthread_t thread_coordenador_id;
-    
-    // Thread do Mural
-    pthread_create(&thread_mural_id, NULL, thread_mural, &g);
-    
-    // Thread de Exibição
-    pthread_create(&thread_exibicao_id, NULL, thread_exibicao, &g);
-    
-    // Threads dos Tedax (até 5)
-    for (int i = 0; i < g.qtd_tedax; i++) {
-        typedef struct {
-            GameState *g;
-            int tedax_id;
-        } TedaxArgs;
-        
-        TedaxArgs *args = malloc(sizeof(TedaxArgs));
-        args->g = &g;
-        args->tedax_id = i;
-        pthread_create(&thread_tedax_ids[i], NULL, thread_tedax, args);
+    // encerrar_partida já acordou todas as threads (e parou o estoque)
+    ciclo_estacionar_threads();
+    transmissao_definir_partida(NULL);
+    painel_definir_partida(NULL);
+    latencia_encerrar_partida();
+    
+    encerrar_tela_partida();
+    definir_entrada_bloqueante(1);
+    erase();
+    refresh();
+    
+    // Threads estacionadas: o resultado é lido sem o mutex
+    resultado->vitoria = todos_modulos_resolvidos(g) && g->qtd_modulos > 0;
+    resultado->tempo_restante = g->tempo_restante;
+    resultado->erros = g->erros_cometidos;
+    resultado->tem_utilizacao = 0;
+    
+    if (g->qtd_modulos == 0) {
+        mvprintw(LINES / 2, COLS / 2 - 15, "Tempo esgotado - Nenhum modulo gerado");
+        refresh();
+        sleep(2);
+        ciclo_terminar_partida();
+        return TELA_MENU;
+    }
+    
+    parar_musica();
+    if (audio_disponivel_global) {
+        if (resultado->vitoria) {
+            tocar_sound_effect("sounds/win.mp3");
+        } else {
+            tocar_sound_effect("sounds/failed.mp3");
+        }
     }
     
-    // Thread do Coordenador
-    pthread_create(&thread_coordenador_id, NULL, thread_coordenador, &g);
+    resultado->placar_gravado = registrar_partida_placar(g, resultado->vitoria, &resultado->placar);
+    resumir_utilizacao(g, &resultado->utilizacao);
+    resultado->tem_utilizacao = 1;
+    const char *prefixo_utilizacao = getenv("TEDAX_UTILIZACAO");
+    if (prefixo_utilizacao) {
+        exportar_utilizacao(g, *prefixo_utilizacao ? prefixo_utilizacao : PREFIXO_UTILIZACAO_PADRAO);
+    }
+    iniciar_fim_partida(&g->instante_encerramento);
+    ciclo_terminar_partida();
+    return TELA_POS_JOGO;
+}
+
+int main(int argc, char *argv[]) {
+    // Fases: valores padrão, sobrescritos por fases.cfg (recarregado ao ser salvo)
+    if (access(ARQUIVO_CONFIG_FASES, R_OK) == 0 && !carregar_config_fases(ARQUIVO_CONFIG_FASES)) {
+        char erro[128];
+        erro_config_fases(erro, sizeof(erro));
+        fprintf(stderr, "Aviso: %s (usando fases padrao)\n", erro);
+    }
     
-    // Thread principal: controla o tempo e verifica condições de vitória/derrota
-    int tick_count = 0;
-    struct timespec ts;
-    ts.tv_sec = 0;
-    ts.tv_nsec = 200000000L; // 0.2 segundos
+    // Leitura do log binário de eventos (não joga)
+    if (argc >= 2 && strcmp(argv[1], "--eventos") == 0) {
+        return imprimir_eventos(argc >= 3 ? argv[2] : ARQUIVO_EVENTOS);
+    }
     
-    while (g.jogo_rodando && !g.jogo_terminou) {
-        nanosleep(&ts, NULL);
-        
-        tick_count++;
-        if (tick_count >= 5) { // 1 segundo
-            pthread_mutex_lock(&g.mutex_jogo);
-            g.tempo_restante--;
-            
-            if (todos_modulos_resolvidos(&g) && g.qtd_modulos > 0) {
-                g.jogo_terminou = 1;
-                g.jogo_rodando = 0;
-                pthread_mutex_unlock(&g.mutex_jogo);
-                break;
-            }
-            
-            if (g.tempo_restante <= 0) {
-                g.jogo_terminou = 1;
-                g.jogo_rodando = 0;
-                pthread_mutex_unlock(&g.mutex_jogo);
-                break;
-            }
-            
-            pthread_mutex_unlock(&g.mutex_jogo);
-            tick_count = 0;
+    // Vazão do pool de bombas do modo Extras (sem tela, sem log de eventos)
+    if (argc >= 2 && strcmp(argv[1], "--bombas") == 0) {
+        return executar_bench_bombas(argc >= 3 ? atoi(argv[2]) : 0, argc >= 4 ? atoi(argv[3]) : 0);
+    }
+    
+    // Custo de decodificar e mixar o áudio, sem placa de som (TEDAX_AUDIO=nulo por padrão)
+    if (argc >= 2 && strcmp(argv[1], "--audio") == 0) {
+        return executar_bench_audio(argc >= 3 ? atoi(argv[2]) : 0, argc >= 4 ? argv[3] : NULL);
+    }
+    
+    // Muitas partidas seguidas nas threads do ciclo: memória e threads devem ficar estáveis
+    if (argc >= 2 && strcmp(argv[1], "--ciclos") == 0) {
+        return executar_stress_ciclo(argc >= 3 ? atol(argv[2]) : 0);
+    }
+    
+    // Políticas de despacho (fifo, sjf, edf) nas mesmas partidas, jogadas por um robô
+    if (argc >= 2 && strcmp(argv[1], "--escalonamento") == 0) {
+        Dificuldade dificuldade = DIFICULDADE_MEDIO;
+        if (argc >= 4 && !protocolo_dificuldade_por_nome(argv[3], &dificuldade)) {
+            fprintf(stderr, "Uso: %s --escalonamento [partidas] [facil|medio|dificil|custom]\n", argv[0]);
+            return 2;
         }
+        return executar_simulacao_escalonamento(argc >= 3 ? atoi(argv[2]) : 0, dificuldade);
     }
     
-    pthread_join(thread_mural_id, NULL);
-    pthread_join(thread_exibicao_id, NULL);
-    for (int i = 0; i < g.qtd_tedax; i++) {
-        pthread_join(thread_tedax_ids[i], NULL);
+    // Log de eventos em todos os modos; esvaziado e fechado em qualquer saída de main
+    iniciar_eventos();
+    atexit(parar_eventos);
+    
+    // Modo protocolo: partida sem ncurses/áudio dirigida por stdin/stdout
+    if (argc >= 2 && strcmp(argv[1], "--protocolo") == 0) {
+        Dificuldade dificuldade = DIFICULDADE_FACIL;
+        if (argc >= 3 && !protocolo_dificuldade_por_nome(argv[2], &dificuldade)) {
+            fprintf(stderr, "Uso: %s --protocolo [facil|medio|dificil|custom]\n", argv[0]);
+            return 2;
+        }
+        return executar_modo_protocolo(dificuldade);
     }
-    pthread_join(thread_coordenador_id, NULL);
     
-    finalizar_ncurses();
-    initscr();
-    cbreak();
-    noecho();
-    keypad(stdscr, TRUE);
-    nodelay(stdscr, FALSE);
-    timeout(-1);
-    curs_set(0);
-    if (has_colors()) {
-        start_color();
-        init_pair(1, COLOR_CYAN, COLOR_BLACK);
-        init_pair(2, COLOR_GREEN, COLOR_BLACK);
-        init_pair(3, COLOR_YELLOW, COLOR_BLACK);
-        init_pair(4, COLOR_RED, COLOR_BLACK);
-        init_pair(5, COLOR_BLUE, COLOR_BLACK);
-        init_pair(6, COLOR_WHITE, COLOR_BLACK);
-        init_pair(7, COLOR_BLACK, COLOR_WHITE);
-    }
-    clear();
-    refresh();
+    // Servidor multi-sessão e cliente fino via socket Unix
+    if (argc >= 2 && strcmp(argv[1], "--servidor") == 0) {
+        return executar_servidor(argc >= 3 ? argv[2] : SOCKET_PADRAO, 0);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--cliente") == 0) {
+        return executar_cliente(argc >= 4 ? argv[3] : SOCKET_PADRAO, argc >= 3 ? argv[2] : "facil");
+    }
+    
+    // Espectadores: --assistir conecta a uma partida; --transmitir publica as partidas deste processo;
+    // --painel lê o painel em memória compartilhada (TEDAX_PAINEL)
+    if (argc >= 2 && strcmp(argv[1], "--assistir") == 0) {
+        return executar_espectador(argc >= 3 ? argv[2] : SOCKET_ESPECTADOR_PADRAO);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--painel") == 0) {
+        return executar_monitor_painel(argc >= 3 ? argv[2] : NOME_PAINEL_PADRAO);
+    }
+    if (argc >= 2 && strcmp(argv[1], "--transmitir") == 0) {
+        const char *caminho = argc >= 3 ? argv[2] : SOCKET_ESPECTADOR_PADRAO;
+        if (!iniciar_transmissao(caminho)) {
+            fprintf(stderr, "Aviso: nao foi possivel transmitir em %s\n", caminho);
+        }
+    }
+    
+    // Painel em memória compartilhada para monitores externos (--painel)
+    const char *nome_painel = getenv("TEDAX_PAINEL");
+    if (nome_painel) {
+        nome_painel = *nome_painel ? nome_painel : NOME_PAINEL_PADRAO;
+        if (!iniciar_painel(nome_painel)) {
+            fprintf(stderr, "Aviso: nao foi possivel criar o painel %s\n", nome_painel);
+        }
+    }
+    
+    // Retomar partida salva (F5 durante o jogo): entra direto na partida, sem menus
+    unsigned char *partida_salva = NULL;
+    size_t tamanho_salva = 0;
+    Dificuldade dificuldade_salva = DIFICULDADE_FACIL;
+    int tedax_salvos = 0;
+    int bancadas_salvas = 0;
+    if (argc >= 2 && strcmp(argv[1], "--carregar") == 0) {
+        partida_salva = ler_arquivo_partida(argc >= 3 ? argv[2] : ARQUIVO_SALVAMENTO, &tamanho_salva);
+        if (!partida_salva || !ler_cabecalho_partida(partida_salva, tamanho_salva, &dificuldade_salva,
+                                                     &tedax_salvos, &bancadas_salvas)) {
+            fprintf(stderr, "Erro: %s\n", erro_salvamento());
+            free(partida_salva);
+            return 1;
+        }
+    }
+    
+    // Inicializar áudio (Música começa desligada)
+    audio_disponivel_global = inicializar_audio();
+    iniciar_monitor_config(ARQUIVO_CONFIG_FASES);
+    
+    // Uma sessão ncurses para o processo inteiro; cada tela é um estado
+    inicializar_ncurses();
+    // Threads da partida criadas aqui, uma vez; entre partidas ficam estacionadas
+    ciclo_iniciar();
     
-            pthread_mutex_lock(&g.mutex_jogo);
-            int vitoria = 0;
-            int tempo_restante_final = g.tempo_restante;
-            int erros_final = g.erros_cometidos;
-            if (todos_modulos_resolvidos(&g) && g.qtd_modulos > 0) {
-                vitoria = 1;
-            } else if (g.qtd_modulos > 0) {
-                vitoria = 0;
-            } else {
-                clear();
-                mvprintw(LINES / 2, COLS / 2 - 15, "Tempo esgotado - Nenhum modulo gerado");
-                refresh();
-                sleep(2);
-                finalizar_ncurses();
-                continue;
+    Dificuldade dificuldade_escolhida = dificuldade_salva;
+    ResultadoPartida resultado;
+    int modo_extras = 0;
+    Tela tela = partida_salva ? TELA_PARTIDA : TELA_MENU;
+    
+    while (tela != TELA_SAIR) {
+        Tela proxima = TELA_SAIR;
+        
+        switch (tela) {
+            case TELA_MENU: {
+                int modo_escolhido = mostrar_menu_principal();
+                if (modo_escolhido == 0 || modo_escolhido == 3) {
+                    // Clássico e Extras escolhem a dificuldade no mesmo menu
+                    modo_extras = modo_escolhido == 3;
+                    proxima = TELA_DIFICULDADE;
+                } else if (modo_escolhido == 5 && config_custom_disponivel()) {
+                    dificuldade_escolhida = DIFICULDADE_CUSTOM;
+                    proxima = TELA_PARTIDA;
+                } else if (modo_escolhido == 5) {
+                    // Custom só existe se fases.cfg tiver a seção [custom]
+                    erase();
+                    mvprintw(LINES / 2, COLS / 2 - 25, "Nenhuma fase [custom] em %s", ARQUIVO_CONFIG_FASES);
+                    mvprintw(LINES / 2 + 2, COLS / 2 - 15, "Pressione qualquer tecla...");
+                    refresh();
+                    getch();
+                    proxima = TELA_MENU;
+                }
+                break;
             }
-            pthread_mutex_unlock(&g.mutex_jogo);
             
-            parar_musica();
-            if (audio_disponivel_global) {
-                if (vitoria) {
-                    tocar_sound_effect("sounds/win.mp3");
-                } else {
-                    tocar_sound_effect("sounds/failed.mp3");
+            case TELA_DIFICULDADE: {
+                int dificuldade_menu = mostrar_menu_dificuldades();
+                proxima = modo_extras ? TELA_EXTRAS : TELA_PARTIDA;
+                switch (dificuldade_menu) {
+                    case 0: // Fácil
+                        dificuldade_escolhida = DIFICULDADE_FACIL;
+                        break;
+                    case 1: // Médio
+                        dificuldade_escolhida = DIFICULDADE_MEDIO;
+                        break;
+                    case 2: // Difícil
+                        dificuldade_escolhida = DIFICULDADE_DIFICIL;
+                        break;
+                    default:
+                        proxima = TELA_MENU;
+                        break;
                 }
+                break;
             }
             
-            int opcao = mostrar_menu_pos_jogo(vitoria, tempo_restante_final, erros_final);
+            case TELA_PARTIDA: {
+                ConfigFase config = obter_config_fase(dificuldade_escolhida);
+                int num_tedax = partida_salva ? tedax_salvos : config.num_tedax;
+                int num_bancadas = partida_salva ? bancadas_salvas : config.num_bancadas;
+                
+                proxima = jogar_partida(dificuldade_escolhida, num_tedax, num_bancadas,
+                                        partida_salva, tamanho_salva, &resultado);
+                free(partida_salva);
+                partida_salva = NULL;
+                break;
+            }
             
-            if (audio_disponivel_global) {
-                while (musica_tocando()) {
-                    struct timespec ts;
-                    ts.tv_sec = 0;
-                    ts.tv_nsec = 100000000L; // 0.1 segundos
-                    nanosleep(&ts, NULL);
-                }
+            case TELA_EXTRAS: {
+                ResultadoExtras extras;
+                parar_musica();
                 definir_dificuldade_musica(0);
-                tocar_musica("sounds/Menu.mp3");
+                if (audio_disponivel_global) {
+                    tocar_musica("sounds/Fase_3.mp3");
+                }
+                jogar_extras(dificuldade_escolhida, &extras);
+                
+                if (extras.modulos_gerados == 0) {
+                    proxima = TELA_MENU;
+                    break;
+                }
+                parar_musica();
+                if (audio_disponivel_global) {
+                    tocar_sound_effect(extras.vitoria ? "sounds/win.mp3" : "sounds/failed.mp3");
+                }
+                
+                // Sem placar: os recordes são por partida de uma bomba
+                resultado.vitoria = extras.vitoria;
+                resultado.tempo_restante = extras.tempo_restante;
+                resultado.erros = extras.erros;
+                resultado.placar_gravado = 0;
+                resultado.tem_utilizacao = 0;
+                proxima = TELA_POS_JOGO;
+                break;
             }
             
-            finalizar_ncurses();
-            
-            if (opcao == 'q' || opcao == 'Q') {
-                printf("Jogo encerrado.\n");
-                return 0;
-            } else if (opcao == 'r' || opcao == 'R') {
-                continue;
+            case TELA_POS_JOGO: {
+                int opcao = mostrar_menu_pos_jogo(resultado.vitoria, resultado.tempo_restante, resultado.erros,
+                                                  resultado.placar_gravado ? &resultado.placar : NULL,
+                                                  resultado.tem_utilizacao ? &resultado.utilizacao : NULL);
+                
+                // O menu volta na hora; a música dele entra quando o efeito de vitória/derrota acabar
+                if (audio_disponivel_global) {
+                    definir_dificuldade_musica(0);
+                    tocar_musica_em_seguida("sounds/Menu.mp3");
+                }
+                
+                proxima = (opcao == 'q' || opcao == 'Q') ? TELA_SAIR : TELA_MENU;
+                break;
             }
-        } else {
-            finalizar_ncurses();
+            
+            case TELA_SAIR:
+                break;
         }
         
-        parar_musica();
+        iniciar_transicao_tela(proxima);
+        tela = proxima;
     }
     
+    ciclo_encerrar();
+    extras_encerrar();
+    finalizar_ncurses();
+    parar_monitor_config();
+    parar_transmissao();
+    parar_painel();
     parar_musica();
     finalizar_audio();
     
+    if (getenv("TEDAX_MEDIR")) {
+        int qtd;
+        double media_ms, max_ms;
+        estatisticas_transicao_tela(&qtd, &media_ms, &max_ms);
+        printf("Trocas de tela: %d (media %.2f ms, max %.2f ms)\n", qtd, media_ms, max_ms);
+        estatisticas_fim_partida(&qtd, &media_ms, &max_ms);
+        printf("Fim da partida -> menu pos-jogo: %d (media %.2f ms, max %.2f ms)\n", qtd, media_ms, max_ms);
+        
+        const char *renderizador;
+        double media_bytes, writes_por_quadro;
+        long long max_bytes;
+        estatisticas_quadros(&renderizador, &qtd, &media_bytes, &max_bytes, &writes_por_quadro);
+        printf("Quadros da partida (%s): %d (media %.0f bytes, max %lld, %.2f write() por quadro)\n",
+               renderizador, qtd, media_bytes, max_bytes, writes_por_quadro);
+        latencia_imprimir_resumos(stdout);
+        
+        if (audio_disponivel_global) {
+            const char *saida;
+            long buffers, atrasados;
+            double cpu_percentual;
+            estatisticas_audio(&saida, &buffers, &media_ms, &max_ms, &cpu_percentual, &atrasados);
+            printf("Audio (%s): %ld buffers, decodificar+mixar %.3f ms por buffer (max %.3f), "
+                   "%.2f%% de um nucleo, %ld buffer(s) atrasado(s)\n", saida, buffers, media_ms, max_ms,
+                   cpu_percentual, atrasados);
+        }
+    }
+    printf("Jogo encerrado.\n");
     return 0;
-    finalizar_jogo(&g);
-    
-    printf("Fim da execucao\n");
-    return 0;
-}
\ No newline at end of file
+}
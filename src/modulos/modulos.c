@@ -1,3 +1,4 @@
+#define _POSIX_C_SOURCE 200809L
 #include "modulos.h"
 #include <stdlib.h>
 #include <string.h>
@@ -21,17 +22,17 @@ static const char mapeamento_hash[9] = {
 };
 
 // Gera uma sequência aleatória de letras A-I com tamanho baseado na dificuldade
-static void gerar_sequencia_senha(char *buffer, int tamanho_max, Dificuldade dificuldade) {
+static void gerar_sequencia_senha(char *buffer, int tamanho_max, Dificuldade dificuldade, unsigned int *rng) {
     int tamanho;
     switch (dificuldade) {
         case DIFICULDADE_FACIL:
-            tamanho = 4 + (rand() % 2); // 3 ou 4 caracteres
+            tamanho = 4 + sortear(rng, 2); // 3 ou 4 caracteres
             break;
         case DIFICULDADE_MEDIO:
-            tamanho = 6 + (rand() % 2); // 4 ou 5 caracteres
+            tamanho = 6 + sortear(rng, 2); // 4 ou 5 caracteres
             break;
         case DIFICULDADE_DIFICIL:
-            tamanho = 8 + (rand() % 2); // 5 ou 6 caracteres
+            tamanho = 8 + sortear(rng, 2); // 5 ou 6 caracteres
             break;
         default:
             tamanho = 4; // Padrão
@@ -45,7 +46,7 @@ static void gerar_sequencia_senha(char *buffer, int tamanho_max, Dificuldade dif
     
     // Gerar sequência aleatória usando apenas A-I
     for (int i = 0; i < tamanho; i++) {
-        buffer[i] = 'A' + (rand() % 9); // A até I (0-8)
+        buffer[i] = 'A' + sortear(rng, 9); // A até I (0-8)
     }
     buffer[tamanho] = '\0';
 }
@@ -55,12 +56,12 @@ static const char* cores_fios[] = {"R", "G", "B", "Y", "W", "K"}; // Vermelho, V
 
 
 // Gera um módulo de botão
-void gerar_modulo_botao(Modulo *mod, Dificuldade dificuldade) {
+void gerar_modulo_botao(Modulo *mod, Dificuldade dificuldade, unsigned int *rng) {
     (void)dificuldade; // Parâmetro não usado, mas mantido para consistência
     mod->tipo = TIPO_BOTAO;
     
     // Sortear cor (0 = Vermelho, 1 = Verde, 2 = Azul)
-    int cor_aleatoria = rand() % 3;
+    int cor_aleatoria = sortear(rng, 3);
     mod->dados.botao.cor = (CorBotao)cor_aleatoria;
     
     // Definir instrução correta baseada na cor
@@ -78,11 +79,11 @@ void gerar_modulo_botao(Modulo *mod, Dificuldade dificuldade) {
 }
 
 // Gera um módulo de senha
-void gerar_modulo_senha(Modulo *mod, Dificuldade dificuldade) {
+void gerar_modulo_senha(Modulo *mod, Dificuldade dificuldade, unsigned int *rng) {
     mod->tipo = TIPO_SENHA;
     
     // Gerar sequência aleatória de letras A-I com tamanho baseado na dificuldade
-    gerar_sequencia_senha(mod->dados.senha.hash, 32, dificuldade);
+    gerar_sequencia_senha(mod->dados.senha.hash, 32, dificuldade, rng);
     
     // Gerar senha numérica baseada no mapeamento
     const char* mapeamento = mapeamento_hash;
@@ -98,10 +99,6 @@ void gerar_modulo_senha(Modulo *mod, Dificuldade dificuldade) {
         }
     }
     
-    // Armazenar índice de dificuldade para validação
-    mod->dados.senha.mapeamento[0] = (char)dificuldade;
-    mod->dados.senha.mapeamento[1] = '\0';
-    
     // A instrução correta é a senha numérica
     strcpy(mod->instrucao_correta, mod->dados.senha.senha_correta);
 }
@@ -117,14 +114,15 @@ static void aplicar_padrao_fios(Modulo *mod) {
     char sequencia[32];
     strcpy(sequencia, mod->dados.fios.sequencia);
     
-    // Contar fios (separados por /)
+    // Contar fios (separados por /); strtok_r: a geração também roda em thread_estoque
     int num_fios = 0;
-    char* token = strtok(sequencia, "/");
+    char *resto;
+    char* token = strtok_r(sequencia, "/", &resto);
     char cores[10][4];
     while (token != NULL && num_fios < 10) {
         strcpy(cores[num_fios], token);
         num_fios++;
-        token = strtok(NULL, "/");
+        token = strtok_r(NULL, "/", &resto);
     }
     
     int padrao = mod->dados.fios.padrao;
@@ -208,19 +206,19 @@ static void aplicar_padrao_fios(Modulo *mod) {
 }
 
 // Gera um módulo de fios
-void gerar_modulo_fios(Modulo *mod, Dificuldade dificuldade) {
+void gerar_modulo_fios(Modulo *mod, Dificuldade dificuldade, unsigned int *rng) {
     (void)dificuldade; // Parâmetro não usado, mas mantido para consistência
     mod->tipo = TIPO_FIOS;
     
     // Escolher padrão aleatório (0-4)
-    mod->dados.fios.padrao = rand() % 5;
+    mod->dados.fios.padrao = sortear(rng, 5);
     
     // Gerar sequência de fios (5 fios)
     int num_fios = 5;
     mod->dados.fios.sequencia[0] = '\0';
     
     for (int i = 0; i < num_fios; i++) {
-        int cor_idx = rand() % 6; // 6 cores disponíveis
+        int cor_idx = sortear(rng, 6); // 6 cores disponíveis
         strcat(mod->dados.fios.sequencia, "/");
         strcat(mod->dados.fios.sequencia, cores_fios[cor_idx]);
     }
@@ -3,10 +3,10 @@
 
 #include "../game/game.h"
 
-// Funções para gerar módulos de cada tipo
-void gerar_modulo_botao(Modulo *mod, Dificuldade dificuldade);
-void gerar_modulo_senha(Modulo *mod, Dificuldade dificuldade);
-void gerar_modulo_fios(Modulo *mod, Dificuldade dificuldade);
+// Funções para gerar módulos de cada tipo (rng: gerador da partida, ver sortear)
+void gerar_modulo_botao(Modulo *mod, Dificuldade dificuldade, unsigned int *rng);
+void gerar_modulo_senha(Modulo *mod, Dificuldade dificuldade, unsigned int *rng);
+void gerar_modulo_fios(Modulo *mod, Dificuldade dificuldade, unsigned int *rng);
 
 // Funções para validar instruções de cada tipo
 int validar_instrucao_botao(const Modulo *mod, const char *instrucao);
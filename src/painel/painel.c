@@ -0,0 +1,251 @@
+#define _POSIX_C_SOURCE 200809L
+#include "painel.h"
+#include "../comum/comum.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static struct {
+    SegmentoPainel *segmento;
+    char nome[64];
+    const GameState *partida;
+    uint32_t partidas;
+    DadosPainel rascunho;       // Montado fora da janela de escrita do seqlock
+} painel;
+
+int iniciar_painel(const char *nome) {
+    if (painel.segmento) {
+        return 1;
+    }
+    int fd = shm_open(nome, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return 0;
+    }
+    if (ftruncate(fd, sizeof(SegmentoPainel)) < 0) {
+        close(fd);
+        shm_unlink(nome);
+        return 0;
+    }
+    void *p = mmap(NULL, sizeof(SegmentoPainel), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        shm_unlink(nome);
+        return 0;
+    }
+
+    // Assinatura por último: leitor que abrir antes disso recusa o segmento
+    SegmentoPainel *s = (SegmentoPainel*)p;
+    memset(&s->dados, 0, sizeof(s->dados));
+    s->versao = VERSAO_PAINEL;
+    s->tamanho = sizeof(SegmentoPainel);
+    atomic_store_explicit(&s->sequencia, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    memcpy(s->assinatura, "TDXP", 4);
+
+    snprintf(painel.nome, sizeof(painel.nome), "%s", nome);
+    painel.segmento = s;
+    return 1;
+}
+
+void parar_painel(void) {
+    if (!painel.segmento) {
+        return;
+    }
+    munmap(painel.segmento, sizeof(SegmentoPainel));
+    shm_unlink(painel.nome);
+    painel.segmento = NULL;
+    painel.partida = NULL;
+}
+
+// Único escritor por vez (mutex_jogo da partida, ou a thread principal entre partidas)
+static void escrever_painel(const DadosPainel *d) {
+    SegmentoPainel *s = painel.segmento;
+    unsigned int seq = atomic_load_explicit(&s->sequencia, memory_order_relaxed);
+    atomic_store_explicit(&s->sequencia, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    memcpy(&s->dados, d, sizeof(*d));
+    atomic_store_explicit(&s->sequencia, seq + 2, memory_order_release);
+}
+
+static void montar_retrato(const GameState *g, DadosPainel *d) {
+    d->partida = painel.partidas;
+    d->semente = g->semente;
+    d->dificuldade = g->dificuldade;
+    d->em_jogo = g->jogo_rodando && !g->jogo_terminou;
+    d->vitoria = todos_modulos_resolvidos(g) && g->qtd_modulos > 0;
+    d->tempo_total = g->tempo_total_partida;
+    d->tempo_restante = g->tempo_restante;
+    d->erros = g->erros_cometidos;
+    d->resolvidos = contar_modulos_resolvidos(g);
+    d->necessarios = g->modulos_necessarios;
+    d->qtd_tedax = g->qtd_tedax;
+    d->qtd_bancadas = g->qtd_bancadas;
+    d->qtd_modulos = g->qtd_modulos;
+
+    for (int i = 0; i < g->qtd_modulos; i++) {
+        PainelModulo *m = &d->modulos[i];
+        m->id = g->quente.id[i];
+        m->tipo = g->modulos[i].tipo;
+        m->estado = g->quente.estado[i];
+        m->tempo_total = g->modulos[i].tempo_total;
+        m->tempo_restante = tempo_restante_modulo(g, i);
+        m->tedax_id = 0;
+    }
+    for (int i = 0; i < g->qtd_tedax; i++) {
+        const Tedax *t = &g->tedax[i];
+        PainelTedax *p = &d->tedax[i];
+        p->id = t->id;
+        p->estado = t->estado;
+        p->modulo_id = t->modulo_atual >= 0 ? g->quente.id[t->modulo_atual] : 0;
+        p->bancada_id = t->bancada_atual >= 0 ? g->bancadas[t->bancada_atual].id : 0;
+        p->qtd_fila = t->qtd_fila;
+        if (t->modulo_atual >= 0 && t->modulo_atual < g->qtd_modulos) {
+            d->modulos[t->modulo_atual].tedax_id = t->id;
+        }
+        for (int k = 0; k < t->qtd_fila; k++) {
+            int m = t->fila[(t->inicio_fila + k) % MAX_FILA_TEDAX].modulo_idx;
+            if (m >= 0 && m < g->qtd_modulos) {
+                d->modulos[m].tedax_id = t->id;
+            }
+        }
+    }
+    for (int i = 0; i < g->qtd_bancadas; i++) {
+        const Bancada *b = &g->bancadas[i];
+        PainelBancada *p = &d->bancadas[i];
+        p->id = b->id;
+        p->estado = b->estado;
+        p->tedax_id = b->tedax_ocupando > 0 ? b->tedax_ocupando : 0;
+        p->qtd_espera = b->espera.qtd;
+    }
+}
+
+void painel_publicar(const GameState *g) {
+    if (!painel.segmento || g != painel.partida) {
+        return;
+    }
+    montar_retrato(g, &painel.rascunho);
+    escrever_painel(&painel.rascunho);
+}
+
+// Chamada com as threads da partida estacionadas
+void painel_definir_partida(const GameState *g) {
+    if (!painel.segmento) {
+        return;
+    }
+    if (g) {
+        painel.partidas++;
+        painel.partida = g;
+        montar_retrato(g, &painel.rascunho);
+    } else {
+        painel.rascunho.em_jogo = 0;
+        painel.partida = NULL;
+    }
+    escrever_painel(&painel.rascunho);
+}
+
+// --- Leitor ---
+
+const SegmentoPainel* abrir_painel(const char *nome) {
+    int fd = shm_open(nome, O_RDONLY, 0);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(SegmentoPainel)) {
+        close(fd);
+        return NULL;
+    }
+    void *p = mmap(NULL, sizeof(SegmentoPainel), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) {
+        return NULL;
+    }
+    const SegmentoPainel *s = (const SegmentoPainel*)p;
+    if (memcmp(s->assinatura, "TDXP", 4) != 0 || s->versao != VERSAO_PAINEL ||
+        s->tamanho != sizeof(SegmentoPainel)) {
+        munmap(p, sizeof(SegmentoPainel));
+        return NULL;
+    }
+    return s;
+}
+
+int ler_painel(const SegmentoPainel *s, DadosPainel *destino, unsigned int *sequencia, long *tentativas) {
+    atomic_uint *seq = (atomic_uint*)&s->sequencia;
+    for (int i = 0; i < TENTATIVAS_PAINEL; i++) {
+        unsigned int antes = atomic_load_explicit(seq, memory_order_acquire);
+        *sequencia = antes;
+        if (!(antes & 1)) {
+            memcpy(destino, &s->dados, sizeof(*destino));
+            atomic_thread_fence(memory_order_acquire);
+            if (atomic_load_explicit(seq, memory_order_relaxed) == antes) {
+                return 1;
+            }
+        }
+        (*tentativas)++;
+        // Uma publicação leva microssegundos; passada a primeira rajada, cede o núcleo ao escritor
+        if (i >= 100) {
+            sched_yield();
+        }
+    }
+    return 0;
+}
+
+int executar_monitor_painel(const char *nome) {
+    const SegmentoPainel *s = abrir_painel(nome);
+    if (!s) {
+        fprintf(stderr, "Erro: painel %s indisponivel (o jogo roda com TEDAX_PAINEL=%s?)\n", nome, nome);
+        return 1;
+    }
+    static const char *estados_tedax[] = { "LIVRE", "OCUPADO", "ESPERANDO" };
+    static DadosPainel d;
+
+    while (1) {
+        // Rajada de 100 ms lendo sem parar: mostra a taxa de leitura e as cópias refeitas
+        long leituras = 0;
+        long tentativas = 0;
+        unsigned int seq = 0;
+        int consistente = 1;
+        struct timespec inicio, agora;
+        clock_gettime(CLOCK_MONOTONIC, &inicio);
+        do {
+            for (int k = 0; k < 1000 && consistente; k++) {
+                consistente = ler_painel(s, &d, &seq, &tentativas);
+                leituras++;
+            }
+            clock_gettime(CLOCK_MONOTONIC, &agora);
+        } while (consistente && ms_entre(&inicio, &agora) < 100.0);
+
+        if (!consistente) {
+            printf("seq %u: painel parado no meio de uma publicacao (jogo encerrado?), retrato desatualizado",
+                   seq);
+        } else if (d.partida == 0) {
+            printf("seq %u: aguardando partida", seq);
+        } else {
+            printf("seq %u partida %u %s: %ds, %d/%d resolvidos, %d erro(s), %d modulo(s) |", seq,
+                   d.partida, d.em_jogo ? "em jogo" : (d.vitoria ? "vitoria" : "encerrada"),
+                   d.tempo_restante, d.resolvidos, d.necessarios, d.erros, d.qtd_modulos);
+            for (int i = 0; i < d.qtd_tedax && i < MAX_TEDAX; i++) {
+                const PainelTedax *t = &d.tedax[i];
+                printf(" T%d %s", t->id, t->estado >= 0 && t->estado <= 2 ? estados_tedax[t->estado] : "?");
+                if (t->modulo_id) {
+                    printf(" M%d", t->modulo_id);
+                }
+                if (t->bancada_id) {
+                    printf(" B%d", t->bancada_id);
+                }
+            }
+        }
+        printf(" | %.1f M leituras/s, %ld refeitas\n", leituras / ms_entre(&inicio, &agora) / 1e3,
+               tentativas);
+        fflush(stdout);
+
+        struct timespec pausa = { 0, 900000000L };
+        nanosleep(&pausa, NULL);
+    }
+    return 0;
+}
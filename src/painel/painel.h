@@ -0,0 +1,93 @@
+#ifndef PAINEL_H
+#define PAINEL_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include "../game/game.h"
+
+// Painel em memória compartilhada POSIX para monitores externos (painel do instrutor).
+// O jogo escreve o retrato do quadro (relógio, módulos, tedax, bancadas, erros) num
+// segmento shm_open protegido por seqlock: `sequencia` fica ímpar durante a escrita e
+// muda a cada publicação. Quem lê mapeia o segmento uma vez e depois copia o retrato sem
+// syscall e sem trava: lê a sequência, copia `dados`, relê a sequência e repete se ela
+// estava ímpar ou mudou. O jogo nunca espera por leitores e eles nunca tocam mutex_jogo.
+//
+// TEDAX_PAINEL=<nome> (vazio: NOME_PAINEL_PADRAO) publica as partidas clássicas deste
+// processo; ./jogo --painel [nome] é um monitor de exemplo.
+
+#define NOME_PAINEL_PADRAO "/tedax_painel"
+#define VERSAO_PAINEL 1
+// Cópias que ler_painel tenta antes de desistir (escritor morto no meio de uma publicação)
+#define TENTATIVAS_PAINEL 10000
+
+typedef struct {
+    int32_t id;
+    int32_t tipo;               // TipoModulo
+    int32_t estado;             // EstadoModulo
+    int32_t tempo_total;
+    int32_t tempo_restante;     // Segundos de execução que faltam
+    int32_t tedax_id;           // Tedax com o módulo em mãos ou na fila (0 = nenhum)
+} PainelModulo;
+
+typedef struct {
+    int32_t id;
+    int32_t estado;             // EstadoTedax
+    int32_t modulo_id;          // 0 = nenhum
+    int32_t bancada_id;         // 0 = nenhuma (ou esperando qualquer uma)
+    int32_t qtd_fila;
+} PainelTedax;
+
+typedef struct {
+    int32_t id;
+    int32_t estado;             // EstadoBancada
+    int32_t tedax_id;           // 0 = livre
+    int32_t qtd_espera;
+} PainelBancada;
+
+typedef struct {
+    uint32_t partida;           // Muda a cada partida publicada
+    uint32_t semente;
+    int32_t dificuldade;
+    int32_t em_jogo;            // 0 = entre partidas ou partida encerrada
+    int32_t vitoria;
+    int32_t tempo_total;
+    int32_t tempo_restante;
+    int32_t erros;
+    int32_t resolvidos;
+    int32_t necessarios;
+    int32_t qtd_tedax;
+    int32_t qtd_bancadas;
+    int32_t qtd_modulos;
+    PainelTedax tedax[MAX_TEDAX];
+    PainelBancada bancadas[MAX_BANCADAS];
+    PainelModulo modulos[MAX_MODULOS];
+} DadosPainel;
+
+typedef struct {
+    char assinatura[4];         // "TDXP"
+    uint32_t versao;
+    uint32_t tamanho;           // sizeof(SegmentoPainel)
+    atomic_uint sequencia;
+    DadosPainel dados;
+} SegmentoPainel;
+
+// Cria o segmento (0 se não conseguir); parar_painel o desfaz (shm_unlink)
+int iniciar_painel(const char *nome);
+void parar_painel(void);
+
+// Partida publicada (NULL: nenhuma; o último retrato fica com em_jogo = 0)
+void painel_definir_partida(const GameState *g);
+// Publica o retrato de g se for a partida do painel (mutex_jogo travado)
+void painel_publicar(const GameState *g);
+
+// Leitor: mapeia o segmento (somente leitura) e copia retratos consistentes
+const SegmentoPainel* abrir_painel(const char *nome);
+// Retorna 1 com um retrato consistente em `destino`, ou 0 se a sequência não estabilizou em
+// TENTATIVAS_PAINEL cópias (`destino` fica inválido). `sequencia` recebe a última lida e
+// `tentativas` soma as cópias refeitas
+int ler_painel(const SegmentoPainel *s, DadosPainel *destino, unsigned int *sequencia, long *tentativas);
+
+// --painel: imprime o quadro publicado uma vez por segundo, até Ctrl+C
+int executar_monitor_painel(const char *nome);
+
+#endif // PAINEL_H
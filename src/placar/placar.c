@@ -0,0 +1,355 @@
+#define _DEFAULT_SOURCE
+#include "placar.h"
+#include "../comum/comum.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+
+#define QTD_DIFICULDADES 4
+#define VERSAO_REGISTRO_PLACAR 1
+#define VERSAO_INDICE_PLACAR 1
+#define TAMANHO_CABECALHO_REGISTRO 44
+#define MAX_TEMPOS_REGISTRO 100
+#define TAMANHO_MAX_REGISTRO (TAMANHO_CABECALHO_REGISTRO + 2 * MAX_TEMPOS_REGISTRO + 4)
+#define TAMANHO_BLOCO_LEITURA 65536
+
+// Registro em placar.log (little-endian):
+//   tamanho u32 | versão u8 | dificuldade u8 | vitória u8 | qtd_tempos u8 | semente u32 |
+//   tempo_restante i32 | erros i32 | quando i64 | jogador[16] | tempos u16[qtd] | FNV-1a u32
+
+typedef struct {
+    char jogador[MAX_NOME_JOGADOR];
+    int tem[QTD_DIFICULDADES];
+    EntradaPlacar melhor[QTD_DIFICULDADES];
+} RecordeJogador;
+
+// placar.idx: cabeçalho seguido de qtd_jogadores RecordeJogador (layout nativo; é só um cache do log)
+typedef struct {
+    char assinatura[4];
+    unsigned int versao;
+    unsigned int tamanho_entrada;
+    unsigned int tamanho_recorde;
+    long long coberto;          // Bytes de placar.log já incorporados
+    long long partidas;
+    int qtd_top[QTD_DIFICULDADES];
+    EntradaPlacar top[QTD_DIFICULDADES][TOP_K_PLACAR];
+    int qtd_jogadores;
+} CabecalhoIndice;
+
+typedef struct {
+    CabecalhoIndice cab;
+    RecordeJogador *jogadores;
+    int capacidade_jogadores;
+} IndicePlacar;
+
+const char* nome_jogador_placar(void) {
+    const char *nome = getenv("TEDAX_JOGADOR");
+    if (!nome || nome[0] == '\0') {
+        nome = getenv("USER");
+    }
+    return (nome && nome[0] != '\0') ? nome : "jogador";
+}
+
+static void escrever_u32(unsigned char *p, uint32_t v) {
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = (v >> 24) & 0xFF;
+}
+
+static uint32_t ler_u32(const unsigned char *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// ---------- Índice ----------
+
+static void indice_vazio(IndicePlacar *idx) {
+    memset(&idx->cab, 0, sizeof(idx->cab));
+    memcpy(idx->cab.assinatura, "TDXI", 4);
+    idx->cab.versao = VERSAO_INDICE_PLACAR;
+    idx->cab.tamanho_entrada = sizeof(EntradaPlacar);
+    idx->cab.tamanho_recorde = sizeof(RecordeJogador);
+    idx->cab.qtd_jogadores = 0;
+}
+
+static void carregar_indice(IndicePlacar *idx) {
+    idx->jogadores = NULL;
+    idx->capacidade_jogadores = 0;
+
+    FILE *f = fopen(ARQUIVO_INDICE_PLACAR, "rb");
+    if (!f) {
+        indice_vazio(idx);
+        return;
+    }
+    int ok = fread(&idx->cab, sizeof(idx->cab), 1, f) == 1 &&
+             memcmp(idx->cab.assinatura, "TDXI", 4) == 0 &&
+             idx->cab.versao == VERSAO_INDICE_PLACAR &&
+             idx->cab.tamanho_entrada == sizeof(EntradaPlacar) &&
+             idx->cab.tamanho_recorde == sizeof(RecordeJogador) &&
+             idx->cab.qtd_jogadores >= 0 && idx->cab.coberto >= 0;
+    if (ok && idx->cab.qtd_jogadores > 0) {
+        idx->capacidade_jogadores = idx->cab.qtd_jogadores;
+        idx->jogadores = malloc(sizeof(RecordeJogador) * (size_t)idx->capacidade_jogadores);
+        ok = idx->jogadores &&
+             fread(idx->jogadores, sizeof(RecordeJogador), (size_t)idx->cab.qtd_jogadores, f) ==
+                 (size_t)idx->cab.qtd_jogadores;
+    }
+    fclose(f);
+
+    if (!ok) {
+        free(idx->jogadores);
+        idx->jogadores = NULL;
+        idx->capacidade_jogadores = 0;
+        indice_vazio(idx);
+    }
+}
+
+static void gravar_indice(const IndicePlacar *idx) {
+    const char *temporario = ARQUIVO_INDICE_PLACAR ".tmp";
+    FILE *f = fopen(temporario, "wb");
+    if (!f) {
+        return;
+    }
+    int ok = fwrite(&idx->cab, sizeof(idx->cab), 1, f) == 1;
+    if (ok && idx->cab.qtd_jogadores > 0) {
+        ok = fwrite(idx->jogadores, sizeof(RecordeJogador), (size_t)idx->cab.qtd_jogadores, f) ==
+             (size_t)idx->cab.qtd_jogadores;
+    }
+    ok = (fclose(f) == 0) && ok;
+    if (!ok || rename(temporario, ARQUIVO_INDICE_PLACAR) != 0) {
+        remove(temporario);
+    }
+}
+
+// Mais tempo restante, depois menos erros, depois quem chegou primeiro
+static int entrada_melhor(const EntradaPlacar *a, const EntradaPlacar *b) {
+    if (a->tempo_restante != b->tempo_restante) {
+        return a->tempo_restante > b->tempo_restante;
+    }
+    if (a->erros != b->erros) {
+        return a->erros < b->erros;
+    }
+    return a->posicao_log < b->posicao_log;
+}
+
+static void inserir_top(EntradaPlacar *top, int *qtd, const EntradaPlacar *e) {
+    int pos = *qtd;
+    while (pos > 0 && entrada_melhor(e, &top[pos - 1])) {
+        pos--;
+    }
+    if (pos >= TOP_K_PLACAR) {
+        return;
+    }
+    int ultimo = (*qtd < TOP_K_PLACAR) ? *qtd : TOP_K_PLACAR - 1;
+    memmove(&top[pos + 1], &top[pos], sizeof(EntradaPlacar) * (size_t)(ultimo - pos));
+    top[pos] = *e;
+    if (*qtd < TOP_K_PLACAR) {
+        (*qtd)++;
+    }
+}
+
+static RecordeJogador* buscar_jogador(IndicePlacar *idx, const char *jogador, int criar) {
+    for (int i = 0; i < idx->cab.qtd_jogadores; i++) {
+        if (strncmp(idx->jogadores[i].jogador, jogador, MAX_NOME_JOGADOR) == 0) {
+            return &idx->jogadores[i];
+        }
+    }
+    if (!criar) {
+        return NULL;
+    }
+    if (idx->cab.qtd_jogadores == idx->capacidade_jogadores) {
+        int nova = idx->capacidade_jogadores ? idx->capacidade_jogadores * 2 : 16;
+        RecordeJogador *novos = realloc(idx->jogadores, sizeof(RecordeJogador) * (size_t)nova);
+        if (!novos) {
+            return NULL;
+        }
+        idx->jogadores = novos;
+        idx->capacidade_jogadores = nova;
+    }
+    RecordeJogador *r = &idx->jogadores[idx->cab.qtd_jogadores++];
+    memset(r, 0, sizeof(*r));
+    strncpy(r->jogador, jogador, MAX_NOME_JOGADOR - 1);
+    return r;
+}
+
+static void aplicar_registro(IndicePlacar *idx, int dificuldade, int vitoria, const EntradaPlacar *e) {
+    idx->cab.partidas++;
+    if (!vitoria || dificuldade < 0 || dificuldade >= QTD_DIFICULDADES) {
+        return;
+    }
+    inserir_top(idx->cab.top[dificuldade], &idx->cab.qtd_top[dificuldade], e);
+    RecordeJogador *r = buscar_jogador(idx, e->jogador, 1);
+    if (r && (!r->tem[dificuldade] || entrada_melhor(e, &r->melhor[dificuldade]))) {
+        r->melhor[dificuldade] = *e;
+        r->tem[dificuldade] = 1;
+    }
+}
+
+// ---------- Log ----------
+
+// Decodifica um registro completo; retorna o tamanho ou 0 se inválido
+static size_t decodificar_registro(const unsigned char *p, size_t disponivel, long long posicao,
+                                   int *dificuldade, int *vitoria, EntradaPlacar *e) {
+    if (disponivel < 4) {
+        return 0;
+    }
+    size_t tamanho = ler_u32(p);
+    if (tamanho < TAMANHO_CABECALHO_REGISTRO + 4 || tamanho > TAMANHO_MAX_REGISTRO || tamanho > disponivel) {
+        return 0;
+    }
+    if (p[4] != VERSAO_REGISTRO_PLACAR || tamanho != TAMANHO_CABECALHO_REGISTRO + 2 * (size_t)p[7] + 4 ||
+        ler_u32(p + tamanho - 4) != fnv1a(p, tamanho - 4)) {
+        return 0;
+    }
+    *dificuldade = p[5];
+    *vitoria = p[6];
+    memset(e, 0, sizeof(*e));
+    e->semente = ler_u32(p + 8);
+    e->tempo_restante = (int)ler_u32(p + 12);
+    e->erros = (int)ler_u32(p + 16);
+    e->quando = (long long)((uint64_t)ler_u32(p + 20) | ((uint64_t)ler_u32(p + 24) << 32));
+    memcpy(e->jogador, p + 28, MAX_NOME_JOGADOR);
+    e->jogador[MAX_NOME_JOGADOR - 1] = '\0';
+    e->posicao_log = posicao;
+    return tamanho;
+}
+
+static size_t codificar_registro(const GameState *g, int vitoria, const char *jogador, long long quando,
+                                 unsigned char *p) {
+    int qtd_tempos = 0;
+    for (int i = 0; i < g->qtd_modulos && qtd_tempos < MAX_TEMPOS_REGISTRO; i++) {
+        if (g->quente.estado[i] == MOD_RESOLVIDO && g->modulos[i].tempo_solucao >= 0) {
+            int t = g->modulos[i].tempo_solucao > 65535 ? 65535 : g->modulos[i].tempo_solucao;
+            p[TAMANHO_CABECALHO_REGISTRO + 2 * qtd_tempos] = t & 0xFF;
+            p[TAMANHO_CABECALHO_REGISTRO + 2 * qtd_tempos + 1] = (t >> 8) & 0xFF;
+            qtd_tempos++;
+        }
+    }
+
+    size_t tamanho = TAMANHO_CABECALHO_REGISTRO + 2 * (size_t)qtd_tempos + 4;
+    escrever_u32(p, (uint32_t)tamanho);
+    p[4] = VERSAO_REGISTRO_PLACAR;
+    p[5] = (unsigned char)g->dificuldade;
+    p[6] = vitoria ? 1 : 0;
+    p[7] = (unsigned char)qtd_tempos;
+    escrever_u32(p + 8, g->semente);
+    escrever_u32(p + 12, (uint32_t)g->tempo_restante);
+    escrever_u32(p + 16, (uint32_t)g->erros_cometidos);
+    escrever_u32(p + 20, (uint32_t)((uint64_t)quando & 0xFFFFFFFFu));
+    escrever_u32(p + 24, (uint32_t)((uint64_t)quando >> 32));
+    memset(p + 28, 0, MAX_NOME_JOGADOR);
+    strncpy((char*)p + 28, jogador, MAX_NOME_JOGADOR - 1);
+    escrever_u32(p + tamanho - 4, fnv1a(p, tamanho - 4));
+    return tamanho;
+}
+
+// Incorpora ao índice o trecho do log ainda não lido. Um registro incompleto no fim
+// (processo morto no meio da escrita) é cortado para o próximo registro ficar alinhado.
+static void atualizar_indice_com_log(int fd, IndicePlacar *idx, long long tamanho_log) {
+    if (idx->cab.coberto > tamanho_log) {
+        free(idx->jogadores);
+        idx->jogadores = NULL;
+        idx->capacidade_jogadores = 0;
+        indice_vazio(idx);
+    }
+    if (idx->cab.coberto == tamanho_log) {
+        return;
+    }
+
+    unsigned char *bloco = malloc(TAMANHO_BLOCO_LEITURA);
+    if (!bloco) {
+        return;
+    }
+    long long pos = idx->cab.coberto;
+    while (pos < tamanho_log) {
+        ssize_t lidos = pread(fd, bloco, TAMANHO_BLOCO_LEITURA, (off_t)pos);
+        if (lidos <= 0) {
+            break;
+        }
+        size_t usado = 0;
+        while (usado < (size_t)lidos) {
+            int dificuldade, vitoria;
+            EntradaPlacar e;
+            size_t n = decodificar_registro(bloco + usado, (size_t)lidos - usado, pos + (long long)usado,
+                                            &dificuldade, &vitoria, &e);
+            if (n == 0) {
+                break;
+            }
+            aplicar_registro(idx, dificuldade, vitoria, &e);
+            usado += n;
+        }
+        if (usado == 0) {
+            break;
+        }
+        pos += (long long)usado;
+    }
+    free(bloco);
+
+    // Lixo maior que um registro não é cauda interrompida: não apaga, só deixa de fora do índice
+    if (pos < tamanho_log && (tamanho_log - pos >= TAMANHO_MAX_REGISTRO || ftruncate(fd, (off_t)pos) != 0)) {
+        pos = tamanho_log;
+    }
+    idx->cab.coberto = pos;
+}
+
+int registrar_partida_placar(const GameState *g, int vitoria, ResumoPlacar *resumo) {
+    memset(resumo, 0, sizeof(*resumo));
+    resumo->dificuldade = g->dificuldade;
+
+    int fd = open(ARQUIVO_PLACAR, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return 0;
+    }
+    // Outros processos (servidor, outra instância) gravam no mesmo log: um de cada vez
+    if (flock(fd, LOCK_EX) != 0) {
+        close(fd);
+        return 0;
+    }
+
+    IndicePlacar idx;
+    carregar_indice(&idx);
+    struct stat st;
+    long long tamanho_log = fstat(fd, &st) == 0 ? (long long)st.st_size : 0;
+    atualizar_indice_com_log(fd, &idx, tamanho_log);
+
+    const char *jogador = nome_jogador_placar();
+    unsigned char registro[TAMANHO_MAX_REGISTRO];
+    size_t tamanho = codificar_registro(g, vitoria, jogador, (long long)time(NULL), registro);
+    long long posicao = idx.cab.coberto;
+    int ok = write(fd, registro, tamanho) == (ssize_t)tamanho;
+    if (ok) {
+        int dificuldade, venceu;
+        EntradaPlacar e;
+        decodificar_registro(registro, tamanho, posicao, &dificuldade, &venceu, &e);
+        aplicar_registro(&idx, dificuldade, venceu, &e);
+        idx.cab.coberto += (long long)tamanho;
+        gravar_indice(&idx);
+    }
+
+    int d = g->dificuldade;
+    resumo->qtd_top = idx.cab.qtd_top[d];
+    memcpy(resumo->top, idx.cab.top[d], sizeof(resumo->top));
+    for (int i = 0; ok && i < resumo->qtd_top; i++) {
+        if (resumo->top[i].posicao_log == posicao) {
+            resumo->posicao_partida = i + 1;
+        }
+    }
+    RecordeJogador *r = buscar_jogador(&idx, jogador, 0);
+    if (r && r->tem[d]) {
+        resumo->tem_recorde = 1;
+        resumo->recorde = r->melhor[d];
+        resumo->novo_recorde = ok && r->melhor[d].posicao_log == posicao;
+    }
+    resumo->partidas_registradas = idx.cab.partidas;
+
+    free(idx.jogadores);
+    flock(fd, LOCK_UN);
+    close(fd);
+    return ok;
+}
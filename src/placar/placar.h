@@ -0,0 +1,43 @@
+#ifndef PLACAR_H
+#define PLACAR_H
+
+#include "../game/game.h"
+
+// Placar persistente: cada partida terminada vira um registro no fim de placar.log
+// (só acrescentado, nunca reescrito). placar.idx guarda o top-k por dificuldade e o
+// recorde de cada jogador, junto com até onde o log já foi lido; ao registrar uma
+// partida só o trecho novo do log é processado, então a consulta não cresce com o
+// número de partidas gravadas. O índice pode ser apagado: é refeito a partir do log.
+
+#define ARQUIVO_PLACAR "placar.log"
+#define ARQUIVO_INDICE_PLACAR "placar.idx"
+#define TOP_K_PLACAR 5
+#define MAX_NOME_JOGADOR 16
+
+typedef struct {
+    char jogador[MAX_NOME_JOGADOR];
+    int tempo_restante;
+    int erros;
+    unsigned int semente;
+    long long quando;           // time(NULL) do fim da partida
+    long long posicao_log;      // Deslocamento do registro em placar.log
+} EntradaPlacar;
+
+typedef struct {
+    Dificuldade dificuldade;
+    EntradaPlacar top[TOP_K_PLACAR];    // Melhores vitórias (mais tempo restante, menos erros)
+    int qtd_top;
+    int posicao_partida;                // 1..TOP_K_PLACAR se esta partida entrou no top, 0 se não
+    int tem_recorde;
+    EntradaPlacar recorde;              // Melhor vitória do jogador nesta dificuldade
+    int novo_recorde;
+    long long partidas_registradas;
+} ResumoPlacar;
+
+// Grava a partida terminada (threads já encerradas) e preenche o resumo para a tela final.
+// Retorna 0 se o placar não pôde ser gravado (o resumo fica zerado).
+int registrar_partida_placar(const GameState *g, int vitoria, ResumoPlacar *resumo);
+
+const char* nome_jogador_placar(void);
+
+#endif // PLACAR_H
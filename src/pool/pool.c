@@ -0,0 +1,254 @@
+#define _POSIX_C_SOURCE 200809L
+#include "pool.h"
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+typedef struct {
+    TarefaPool funcao;
+    void *arg;
+} ItemPool;
+
+// Deque circular: o dono usa o fim, ladrões o início
+typedef struct {
+    pthread_mutex_t mutex;
+    ItemPool itens[CAPACIDADE_DEQUE_POOL];
+    int inicio;
+    int qtd;
+    atomic_llong executadas;
+    atomic_llong roubadas;
+} DequePool;
+
+struct PoolThreads {
+    int num_workers;
+    pthread_t threads[MAX_WORKERS_POOL];
+    DequePool deques[MAX_WORKERS_POOL];
+    atomic_uint rodizio;
+
+    atomic_int disponiveis;     // Tarefas nos deques, ainda não pegas
+    atomic_int pendentes;       // Enviadas e não terminadas (inclui as em execução)
+
+    pthread_mutex_t mutex;      // Sono dos workers e espera de pool_esperar
+    pthread_cond_t cond_trabalho;
+    pthread_cond_t cond_fim;
+    int dormindo;
+    int encerrar;
+};
+
+typedef struct {
+    PoolThreads *pool;
+    int indice;
+} ArgsWorker;
+
+// Worker (e pool) da thread atual; -1 fora de um pool
+static _Thread_local PoolThreads *pool_da_thread = NULL;
+static _Thread_local int indice_da_thread = -1;
+
+static int empilhar(DequePool *d, TarefaPool funcao, void *arg) {
+    pthread_mutex_lock(&d->mutex);
+    if (d->qtd >= CAPACIDADE_DEQUE_POOL) {
+        pthread_mutex_unlock(&d->mutex);
+        return 0;
+    }
+    ItemPool *item = &d->itens[(d->inicio + d->qtd) % CAPACIDADE_DEQUE_POOL];
+    item->funcao = funcao;
+    item->arg = arg;
+    d->qtd++;
+    pthread_mutex_unlock(&d->mutex);
+    return 1;
+}
+
+static int tirar_do_fim(DequePool *d, ItemPool *item) {
+    pthread_mutex_lock(&d->mutex);
+    if (d->qtd == 0) {
+        pthread_mutex_unlock(&d->mutex);
+        return 0;
+    }
+    d->qtd--;
+    *item = d->itens[(d->inicio + d->qtd) % CAPACIDADE_DEQUE_POOL];
+    pthread_mutex_unlock(&d->mutex);
+    return 1;
+}
+
+static int tirar_do_inicio(DequePool *d, ItemPool *item) {
+    pthread_mutex_lock(&d->mutex);
+    if (d->qtd == 0) {
+        pthread_mutex_unlock(&d->mutex);
+        return 0;
+    }
+    *item = d->itens[d->inicio];
+    d->inicio = (d->inicio + 1) % CAPACIDADE_DEQUE_POOL;
+    d->qtd--;
+    pthread_mutex_unlock(&d->mutex);
+    return 1;
+}
+
+static void concluir_tarefa(PoolThreads *p) {
+    if (atomic_fetch_sub(&p->pendentes, 1) == 1) {
+        pthread_mutex_lock(&p->mutex);
+        pthread_cond_broadcast(&p->cond_fim);
+        pthread_mutex_unlock(&p->mutex);
+    }
+}
+
+// Próxima tarefa para o worker i: a do próprio deque ou uma roubada de outro
+static int pegar_tarefa(PoolThreads *p, int i, ItemPool *item) {
+    if (tirar_do_fim(&p->deques[i], item)) {
+        return 1;
+    }
+    for (int k = 1; k < p->num_workers; k++) {
+        int vitima = (i + k) % p->num_workers;
+        if (tirar_do_inicio(&p->deques[vitima], item)) {
+            atomic_fetch_add_explicit(&p->deques[i].roubadas, 1, memory_order_relaxed);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void* thread_worker_pool(void *arg) {
+    ArgsWorker *args = (ArgsWorker*)arg;
+    PoolThreads *p = args->pool;
+    int i = args->indice;
+    free(args);
+    pool_da_thread = p;
+    indice_da_thread = i;
+
+    while (1) {
+        ItemPool item;
+        if (atomic_load(&p->disponiveis) > 0 && pegar_tarefa(p, i, &item)) {
+            atomic_fetch_sub(&p->disponiveis, 1);
+            item.funcao(item.arg);
+            atomic_fetch_add_explicit(&p->deques[i].executadas, 1, memory_order_relaxed);
+            concluir_tarefa(p);
+            continue;
+        }
+
+        // disponiveis só sobe com p->mutex travado: o aviso de pool_enviar não se perde.
+        // Pode ficar negativo por um instante (tarefa pega antes de pool_enviar contar)
+        pthread_mutex_lock(&p->mutex);
+        while (atomic_load(&p->disponiveis) <= 0 && !p->encerrar) {
+            p->dormindo++;
+            pthread_cond_wait(&p->cond_trabalho, &p->mutex);
+            p->dormindo--;
+        }
+        int sair = p->encerrar && atomic_load(&p->disponiveis) <= 0;
+        pthread_mutex_unlock(&p->mutex);
+        if (sair) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+// Acorda e espera os `qtd` primeiros workers (sem tarefas pendentes)
+static void parar_workers(PoolThreads *p, int qtd) {
+    pthread_mutex_lock(&p->mutex);
+    p->encerrar = 1;
+    pthread_cond_broadcast(&p->cond_trabalho);
+    pthread_mutex_unlock(&p->mutex);
+    for (int i = 0; i < qtd; i++) {
+        pthread_join(p->threads[i], NULL);
+    }
+}
+
+static void liberar_pool(PoolThreads *p) {
+    for (int i = 0; i < p->num_workers; i++) {
+        pthread_mutex_destroy(&p->deques[i].mutex);
+    }
+    pthread_mutex_destroy(&p->mutex);
+    pthread_cond_destroy(&p->cond_trabalho);
+    pthread_cond_destroy(&p->cond_fim);
+    free(p);
+}
+
+PoolThreads* pool_criar(int num_workers) {
+    if (num_workers < 1) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_workers = cpus > 0 ? (int)cpus : 1;
+    }
+    if (num_workers > MAX_WORKERS_POOL) {
+        num_workers = MAX_WORKERS_POOL;
+    }
+
+    PoolThreads *p = calloc(1, sizeof(PoolThreads));
+    if (!p) {
+        return NULL;
+    }
+    p->num_workers = num_workers;
+    pthread_mutex_init(&p->mutex, NULL);
+    pthread_cond_init(&p->cond_trabalho, NULL);
+    pthread_cond_init(&p->cond_fim, NULL);
+    for (int i = 0; i < num_workers; i++) {
+        pthread_mutex_init(&p->deques[i].mutex, NULL);
+    }
+    for (int i = 0; i < num_workers; i++) {
+        ArgsWorker *args = malloc(sizeof(ArgsWorker));
+        if (args) {
+            args->pool = p;
+            args->indice = i;
+        }
+        if (!args || pthread_create(&p->threads[i], NULL, thread_worker_pool, args) != 0) {
+            // Desfaz: encerra os workers já criados e libera o pool
+            free(args);
+            parar_workers(p, i);
+            liberar_pool(p);
+            return NULL;
+        }
+    }
+    return p;
+}
+
+void pool_destruir(PoolThreads *p) {
+    if (!p) {
+        return;
+    }
+    pool_esperar(p);
+    parar_workers(p, p->num_workers);
+    liberar_pool(p);
+}
+
+void pool_enviar(PoolThreads *p, TarefaPool funcao, void *arg) {
+    atomic_fetch_add(&p->pendentes, 1);
+
+    int inicio = (pool_da_thread == p) ? indice_da_thread
+                                       : (int)(atomic_fetch_add(&p->rodizio, 1) % (unsigned)p->num_workers);
+    int colocada = 0;
+    for (int k = 0; k < p->num_workers && !colocada; k++) {
+        colocada = empilhar(&p->deques[(inicio + k) % p->num_workers], funcao, arg);
+    }
+    if (!colocada) {
+        funcao(arg);
+        concluir_tarefa(p);
+        return;
+    }
+
+    pthread_mutex_lock(&p->mutex);
+    atomic_fetch_add(&p->disponiveis, 1);
+    if (p->dormindo > 0) {
+        pthread_cond_signal(&p->cond_trabalho);
+    }
+    pthread_mutex_unlock(&p->mutex);
+}
+
+void pool_esperar(PoolThreads *p) {
+    pthread_mutex_lock(&p->mutex);
+    while (atomic_load(&p->pendentes) > 0) {
+        pthread_cond_wait(&p->cond_fim, &p->mutex);
+    }
+    pthread_mutex_unlock(&p->mutex);
+}
+
+int pool_qtd_workers(const PoolThreads *p) {
+    return p->num_workers;
+}
+
+void pool_estatisticas(const PoolThreads *p, long long *executadas, long long *roubadas) {
+    *executadas = 0;
+    *roubadas = 0;
+    for (int i = 0; i < p->num_workers; i++) {
+        *executadas += atomic_load_explicit(&p->deques[i].executadas, memory_order_relaxed);
+        *roubadas += atomic_load_explicit(&p->deques[i].roubadas, memory_order_relaxed);
+    }
+}
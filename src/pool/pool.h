@@ -0,0 +1,31 @@
+#ifndef POOL_H
+#define POOL_H
+
+// Pool de threads com roubo de tarefas. Cada worker tem seu deque (com trava própria):
+// o dono tira do fim (a tarefa mais recente, ainda quente no cache) e quem ficou sem
+// trabalho rouba do início do deque de outro. Tarefas enviadas de fora do pool são
+// distribuídas em rodízio; enviadas por uma tarefa, vão para o deque do próprio worker.
+// Workers sem nada para fazer dormem numa condição, sem consumir CPU.
+
+#define MAX_WORKERS_POOL 64
+#define CAPACIDADE_DEQUE_POOL 1024
+
+typedef void (*TarefaPool)(void *arg);
+
+typedef struct PoolThreads PoolThreads;
+
+// num_workers < 1: um por núcleo online. Retorna NULL sem memória ou sem threads
+PoolThreads* pool_criar(int num_workers);
+// Espera as tarefas pendentes e encerra os workers
+void pool_destruir(PoolThreads *p);
+
+// Nunca bloqueia: com todos os deques cheios, a tarefa roda na hora em quem enviou
+void pool_enviar(PoolThreads *p, TarefaPool funcao, void *arg);
+// Até todas as tarefas enviadas (inclusive as que elas enviaram) terminarem; não chamar de uma tarefa
+void pool_esperar(PoolThreads *p);
+
+int pool_qtd_workers(const PoolThreads *p);
+// Somatório desde pool_criar; chamar com o pool parado (depois de pool_esperar)
+void pool_estatisticas(const PoolThreads *p, long long *executadas, long long *roubadas);
+
+#endif // POOL_H
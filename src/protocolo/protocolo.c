@@ -0,0 +1,297 @@
+#define _POSIX_C_SOURCE 200809L
+#include "protocolo.h"
+#include "../fases/fases.h"
+#include "../modulos/modulos.h"
+#include "../salvamento/salvamento.h"
+#include "../comum/comum.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+
+// Serializa escritas em stdout entre a thread de entrada e o laço de quadros
+static pthread_mutex_t mutex_saida = PTHREAD_MUTEX_INITIALIZER;
+
+// Acorda a thread de entrada parada no poll quando a partida acaba por vitória/derrota
+static int pipe_fim[2] = { -1, -1 };
+
+static void escrever_fila_espera(const FilaEspera *f, char *buffer, size_t tamanho, size_t *pos) {
+    if (f->qtd == 0) {
+        acrescentar(buffer, tamanho, pos, "-");
+        return;
+    }
+    for (int k = 0; k < f->qtd; k++) {
+        acrescentar(buffer, tamanho, pos, k ? ",%d" : "%d", f->tedax_ids[(f->inicio + k) % MAX_TEDAX]);
+    }
+}
+
+size_t protocolo_escrever_quadro(const GameState *g, char *buffer, size_t tamanho) {
+    size_t pos = 0;
+    buffer[0] = '\0';
+
+    acrescentar(buffer, tamanho, &pos, "ESTADO dificuldade=%s tempo=%d resolvidos=%d necessarios=%d erros=%d\n",
+                nome_dificuldade(g->dificuldade), g->tempo_restante,
+                contar_modulos_resolvidos(g), g->modulos_necessarios, g->erros_cometidos);
+
+    for (int i = 0; i < g->qtd_tedax; i++) {
+        const Tedax *t = &g->tedax[i];
+        acrescentar(buffer, tamanho, &pos, "TEDAX id=%d estado=%s modulo=%d bancada=%d fila=",
+                    t->id, nome_estado_tedax(t->estado),
+                    t->modulo_atual >= 0 ? g->quente.id[t->modulo_atual] : 0,
+                    t->bancada_atual >= 0 ? g->bancadas[t->bancada_atual].id : 0);
+        if (t->qtd_fila == 0) {
+            acrescentar(buffer, tamanho, &pos, "-");
+        }
+        for (int k = 0; k < t->qtd_fila; k++) {
+            int idx = t->fila[(t->inicio_fila + k) % MAX_FILA_TEDAX].modulo_idx;
+            acrescentar(buffer, tamanho, &pos, k ? ",%d" : "%d", g->quente.id[idx]);
+        }
+        acrescentar(buffer, tamanho, &pos, "\n");
+    }
+
+    for (int i = 0; i < g->qtd_bancadas; i++) {
+        const Bancada *b = &g->bancadas[i];
+        acrescentar(buffer, tamanho, &pos, "BANCADA id=%d estado=%s tedax=%d espera=",
+                    b->id, b->estado == BANCADA_LIVRE ? "LIVRE" : "OCUPADA",
+                    b->tedax_ocupando > 0 ? b->tedax_ocupando : 0);
+        escrever_fila_espera(&b->espera, buffer, tamanho, &pos);
+        acrescentar(buffer, tamanho, &pos, "\n");
+    }
+    if (g->espera_global.qtd > 0) {
+        acrescentar(buffer, tamanho, &pos, "ESPERA_GERAL tedax=");
+        escrever_fila_espera(&g->espera_global, buffer, tamanho, &pos);
+        acrescentar(buffer, tamanho, &pos, "\n");
+    }
+
+    for (int i = 0; i < g->qtd_modulos; i++) {
+        const Modulo *mod = &g->modulos[i];
+        acrescentar(buffer, tamanho, &pos, "MODULO id=%d tipo=%s estado=%s tempo=%d/%d",
+                    g->quente.id[i], nome_tipo_modulo(mod->tipo), nome_estado_modulo(g->quente.estado[i]),
+                    tempo_restante_modulo(g, i), mod->tempo_total);
+        switch (mod->tipo) {
+            case TIPO_BOTAO:
+                acrescentar(buffer, tamanho, &pos, " cor=%s\n", nome_cor(mod->dados.botao.cor));
+                break;
+            case TIPO_SENHA:
+                acrescentar(buffer, tamanho, &pos, " hash=%s\n", mod->dados.senha.hash);
+                break;
+            case TIPO_FIOS:
+                acrescentar(buffer, tamanho, &pos, " fios=%s padrao=%d\n",
+                            mod->dados.fios.sequencia, mod->dados.fios.padrao);
+                break;
+            default:
+                acrescentar(buffer, tamanho, &pos, "\n");
+                break;
+        }
+    }
+
+    acrescentar(buffer, tamanho, &pos, "FIM_QUADRO\n");
+    return pos;
+}
+
+// SALVAR [arquivo] / CARREGAR [arquivo]: retrato binário da partida (mutex_jogo travado)
+static void processar_salvamento(GameState *g, const char *linha, char *resposta, size_t tamanho, size_t *pos) {
+    static unsigned char retrato[TAMANHO_MAX_SALVAMENTO];
+    const char *caminho = strchr(linha, ' ');
+    while (caminho && *caminho == ' ') {
+        caminho++;
+    }
+    if (!caminho || *caminho == '\0') {
+        caminho = ARQUIVO_SALVAMENTO;
+    }
+
+    if (linha[0] == 'S') {
+        size_t n = serializar_partida(g, retrato, sizeof(retrato));
+        if (n > 0 && gravar_arquivo_partida(caminho, retrato, n)) {
+            acrescentar(resposta, tamanho, pos, "OK %zu\n", n);
+        } else {
+            acrescentar(resposta, tamanho, pos, "ERRO Falha ao salvar\n");
+        }
+        return;
+    }
+
+    size_t n = 0;
+    unsigned char *dados = ler_arquivo_partida(caminho, &n);
+    if (dados && restaurar_partida(g, dados, n)) {
+        acrescentar(resposta, tamanho, pos, "OK\n");
+    } else {
+        acrescentar(resposta, tamanho, pos, "ERRO %s\n", erro_salvamento());
+    }
+    free(dados);
+}
+
+size_t protocolo_processar_linha(GameState *g, const char *linha, char *resposta, size_t tamanho,
+                                 int permite_salvamento) {
+    size_t pos = 0;
+    resposta[0] = '\0';
+
+    if (strcmp(linha, "Q") == 0 || strcmp(linha, "q") == 0) {
+        encerrar_partida(g, 0);
+        acrescentar(resposta, tamanho, &pos, "OK\n");
+    } else if (strncmp(linha, "SALVAR", 6) == 0 || strncmp(linha, "CARREGAR", 8) == 0) {
+        if (permite_salvamento) {
+            processar_salvamento(g, linha, resposta, tamanho, &pos);
+        } else {
+            acrescentar(resposta, tamanho, &pos, "ERRO Salvamento indisponivel no servidor\n");
+        }
+    } else if (executar_comando(g, linha)) {
+        acrescentar(resposta, tamanho, &pos, "OK\n");
+    } else {
+        acrescentar(resposta, tamanho, &pos, "ERRO %s\n", g->mensagem_erro);
+    }
+    return pos;
+}
+
+size_t protocolo_escrever_fim(const GameState *g, char *buffer, size_t tamanho) {
+    size_t pos = 0;
+    int vitoria = todos_modulos_resolvidos(g) && g->qtd_modulos > 0;
+    acrescentar(buffer, tamanho, &pos, "FIM vitoria=%d tempo=%d resolvidos=%d erros=%d\n",
+                vitoria, g->tempo_restante, contar_modulos_resolvidos(g), g->erros_cometidos);
+    return pos;
+}
+
+int protocolo_dificuldade_por_nome(const char *nome, Dificuldade *dificuldade) {
+    if (strcmp(nome, "facil") == 0) {
+        *dificuldade = DIFICULDADE_FACIL;
+    } else if (strcmp(nome, "medio") == 0) {
+        *dificuldade = DIFICULDADE_MEDIO;
+    } else if (strcmp(nome, "dificil") == 0) {
+        *dificuldade = DIFICULDADE_DIFICIL;
+    } else if (strcmp(nome, "custom") == 0) {
+        *dificuldade = DIFICULDADE_CUSTOM;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+static void escrever_saida(const char *dados, size_t tamanho) {
+    pthread_mutex_lock(&mutex_saida);
+    fwrite(dados, 1, tamanho, stdout);
+    fflush(stdout);
+    pthread_mutex_unlock(&mutex_saida);
+}
+
+// Lê comandos de stdin; o fim da partida chega por pipe_fim (sem ele, poll com timeout). EOF encerra a partida
+static void* thread_entrada_protocolo(void *arg) {
+    GameState *g = (GameState*)arg;
+    char linha[128];
+    size_t len = 0;
+    char resposta[128];
+
+    while (g->jogo_rodando && !g->jogo_terminou) {
+        struct pollfd pfd[2] = {
+            { .fd = STDIN_FILENO, .events = POLLIN },
+            { .fd = pipe_fim[0], .events = POLLIN }
+        };
+        if (poll(pfd, 2, pipe_fim[0] >= 0 ? -1 : 100) <= 0 || !(pfd[0].revents & (POLLIN | POLLHUP))) {
+            continue;
+        }
+
+        // Um read por lote: um cliente scriptado manda muitas linhas de uma vez
+        char buffer[512];
+        ssize_t lido = read(STDIN_FILENO, buffer, sizeof(buffer));
+        if (lido <= 0) {
+            pthread_mutex_lock(&g->mutex_jogo);
+            encerrar_partida(g, 0);
+            pthread_mutex_unlock(&g->mutex_jogo);
+            break;
+        }
+
+        for (ssize_t i = 0; i < lido && g->jogo_rodando && !g->jogo_terminou; i++) {
+            char c = buffer[i];
+            if (c != '\n') {
+                if (c != '\r' && len < sizeof(linha) - 1) {
+                    linha[len++] = c;
+                }
+                continue;
+            }
+            linha[len] = '\0';
+            len = 0;
+            if (linha[0] == '\0') {
+                continue;
+            }
+
+            pthread_mutex_lock(&g->mutex_jogo);
+            size_t n = protocolo_processar_linha(g, linha, resposta, sizeof(resposta), 1);
+            pthread_mutex_unlock(&g->mutex_jogo);
+            escrever_saida(resposta, n);
+        }
+    }
+
+    return NULL;
+}
+
+int executar_modo_protocolo(Dificuldade dificuldade) {
+    static GameState g;
+    static char quadro[TAMANHO_QUADRO_PROTOCOLO];
+
+    ConfigFase config = obter_config_fase(dificuldade);
+    inicializar_jogo(&g, dificuldade, config.num_tedax, config.num_bancadas);
+
+    pthread_t thread_mural_id;
+    pthread_t thread_estoque_id;
+    pthread_t thread_entrada_id;
+    pthread_t thread_tedax_ids[MAX_TEDAX];
+    TedaxArgs args_tedax[MAX_TEDAX];
+
+    g.threads_da_partida = 1;
+    if (pipe(pipe_fim) != 0) {
+        pipe_fim[0] = pipe_fim[1] = -1;
+    }
+    pthread_create(&thread_mural_id, NULL, thread_mural, &g);
+    pthread_create(&thread_estoque_id, NULL, thread_estoque, &g);
+    for (int i = 0; i < g.qtd_tedax; i++) {
+        args_tedax[i].g = &g;
+        args_tedax[i].tedax_id = i;
+        pthread_create(&thread_tedax_ids[i], NULL, thread_tedax, &args_tedax[i]);
+    }
+    pthread_create(&thread_entrada_id, NULL, thread_entrada_protocolo, &g);
+
+    // Mesmo relógio da partida interativa: quadro e tick da roda a cada 0.2s
+    while (g.jogo_rodando && !g.jogo_terminou) {
+        pthread_mutex_lock(&g.mutex_jogo);
+        size_t n = protocolo_escrever_quadro(&g, quadro, sizeof(quadro));
+        pthread_mutex_unlock(&g.mutex_jogo);
+        escrever_saida(quadro, n);
+
+        if (!dormir_partida(&g, 200000000L)) {
+            break;
+        }
+
+        pthread_mutex_lock(&g.mutex_jogo);
+        int terminou = avancar_tick_partida(&g);
+        pthread_mutex_unlock(&g.mutex_jogo);
+        if (terminou) {
+            break;
+        }
+    }
+
+    // encerrar_partida já acordou as threads da partida; só a entrada espera no poll
+    if (pipe_fim[1] >= 0) {
+        ssize_t escrito = write(pipe_fim[1], "", 1);
+        (void)escrito;
+    }
+    pthread_join(thread_mural_id, NULL);
+    pthread_join(thread_estoque_id, NULL);
+    for (int i = 0; i < g.qtd_tedax; i++) {
+        pthread_join(thread_tedax_ids[i], NULL);
+    }
+    pthread_join(thread_entrada_id, NULL);
+    if (pipe_fim[0] >= 0) {
+        close(pipe_fim[0]);
+        close(pipe_fim[1]);
+    }
+
+    pthread_mutex_lock(&g.mutex_jogo);
+    int vitoria = todos_modulos_resolvidos(&g) && g.qtd_modulos > 0;
+    size_t n = protocolo_escrever_fim(&g, quadro, sizeof(quadro));
+    pthread_mutex_unlock(&g.mutex_jogo);
+    escrever_saida(quadro, n);
+
+    finalizar_jogo(&g);
+    return vitoria ? 0 : 1;
+}
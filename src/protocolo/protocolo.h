@@ -0,0 +1,30 @@
+#ifndef PROTOCOLO_H
+#define PROTOCOLO_H
+
+#include <stddef.h>
+#include "../game/game.h"
+
+// Protocolo de linhas para clientes scriptados (sem ncurses)
+//   Saída: um quadro por tick (ESTADO/TEDAX/BANCADA/MODULO ... FIM_QUADRO),
+//          respostas OK / ERRO <motivo> e, ao final, FIM vitoria=<0|1> ...
+//   Entrada: uma linha por comando no formato T<n>B<n>M<n>:<instr>; Q encerra
+
+#define TAMANHO_QUADRO_PROTOCOLO 16384
+
+// Escreve o quadro do estado atual em 'buffer' (mutex_jogo travado); retorna bytes escritos
+size_t protocolo_escrever_quadro(const GameState *g, char *buffer, size_t tamanho);
+
+// Aplica uma linha de comando e escreve a resposta (mutex_jogo travado); retorna bytes escritos.
+// SALVAR/CARREGAR só com `permite_salvamento` (modo protocolo local; o servidor recusa: os
+// caminhos viriam de clientes e o disco seria lido/escrito na thread do epoll)
+size_t protocolo_processar_linha(GameState *g, const char *linha, char *resposta, size_t tamanho,
+                                 int permite_salvamento);
+
+size_t protocolo_escrever_fim(const GameState *g, char *buffer, size_t tamanho);
+
+int protocolo_dificuldade_por_nome(const char *nome, Dificuldade *dificuldade);
+
+// Joga uma partida inteira via stdin/stdout; retorna 0 em vitória, 1 em derrota
+int executar_modo_protocolo(Dificuldade dificuldade);
+
+#endif // PROTOCOLO_H
@@ -0,0 +1,546 @@
+#define _POSIX_C_SOURCE 200809L
+#include "salvamento.h"
+#include "../comum/comum.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+static char mensagem_erro_salvamento[128] = "";
+
+typedef struct {
+    unsigned char *dados;
+    size_t pos;
+    size_t tamanho;
+    int ok;
+} Escritor;
+
+typedef struct {
+    const unsigned char *dados;
+    size_t pos;
+    size_t tamanho;
+    int ok;
+    int versao;
+} Leitor;
+
+static void falhar(const char *motivo) {
+    snprintf(mensagem_erro_salvamento, sizeof(mensagem_erro_salvamento), "%s", motivo);
+}
+
+const char* erro_salvamento(void) {
+    return mensagem_erro_salvamento;
+}
+
+// ---------- Escrita ----------
+
+static void escrever_bytes(Escritor *e, const void *dados, size_t n) {
+    if (!e->ok || e->pos + n > e->tamanho) {
+        e->ok = 0;
+        return;
+    }
+    memcpy(e->dados + e->pos, dados, n);
+    e->pos += n;
+}
+
+static void escrever_u32(Escritor *e, uint32_t v) {
+    unsigned char b[4] = { v & 0xFF, (v >> 8) & 0xFF, (v >> 16) & 0xFF, (v >> 24) & 0xFF };
+    escrever_bytes(e, b, 4);
+}
+
+static void escrever_int(Escritor *e, int v) {
+    escrever_u32(e, (uint32_t)v);
+}
+
+static void escrever_texto(Escritor *e, const char *texto, size_t capacidade) {
+    size_t n = strnlen(texto, capacidade - 1);
+    unsigned char len = (unsigned char)n;
+    escrever_bytes(e, &len, 1);
+    escrever_bytes(e, texto, n);
+}
+
+static void escrever_fila_espera(Escritor *e, const FilaEspera *f) {
+    escrever_int(e, f->qtd);
+    for (int k = 0; k < f->qtd; k++) {
+        int pos = (f->inicio + k) % MAX_TEDAX;
+        escrever_int(e, f->tedax_ids[pos]);
+        escrever_u32(e, f->tickets[pos]);
+    }
+}
+
+// A ordem dos campos no arquivo não depende de onde cada um fica na memória
+static void escrever_modulo(Escritor *e, const GameState *g, int i) {
+    const Modulo *mod = &g->modulos[i];
+    escrever_int(e, g->quente.id[i]);
+    escrever_int(e, mod->tipo);
+    escrever_int(e, g->quente.estado[i]);
+    escrever_int(e, mod->tempo_total);
+    escrever_int(e, tempo_restante_modulo(g, i));
+    escrever_int(e, segundos_desde_resolvido(g, i));
+    escrever_int(e, g->quente.reservado[i]);
+    escrever_int(e, mod->criado_em);
+    escrever_int(e, mod->tempo_solucao);
+    escrever_texto(e, mod->instrucao_correta, sizeof(mod->instrucao_correta));
+    escrever_texto(e, mod->instrucao_digitada, sizeof(mod->instrucao_digitada));
+
+    switch (mod->tipo) {
+        case TIPO_BOTAO:
+            escrever_int(e, mod->dados.botao.cor);
+            break;
+        case TIPO_SENHA:
+            escrever_texto(e, mod->dados.senha.hash, sizeof(mod->dados.senha.hash));
+            escrever_texto(e, mod->dados.senha.senha_correta, sizeof(mod->dados.senha.senha_correta));
+            break;
+        case TIPO_FIOS:
+            escrever_texto(e, mod->dados.fios.sequencia, sizeof(mod->dados.fios.sequencia));
+            escrever_int(e, mod->dados.fios.padrao);
+            escrever_texto(e, mod->dados.fios.instrucao_correta, sizeof(mod->dados.fios.instrucao_correta));
+            break;
+    }
+}
+
+size_t serializar_partida(const GameState *g, unsigned char *buffer, size_t tamanho) {
+    Escritor e = { buffer, 0, tamanho, 1 };
+
+    escrever_bytes(&e, "TDXS", 4);
+    unsigned char versao[4] = { VERSAO_SALVAMENTO & 0xFF, VERSAO_SALVAMENTO >> 8, 0, 0 };
+    escrever_bytes(&e, versao, 4);
+
+    escrever_int(&e, g->dificuldade);
+    escrever_int(&e, g->qtd_tedax);
+    escrever_int(&e, g->qtd_bancadas);
+    escrever_int(&e, g->tempo_total_partida);
+    escrever_int(&e, g->tempo_restante);
+    escrever_int(&e, g->proximo_id_modulo);
+    escrever_int(&e, g->modulos_necessarios);
+    escrever_int(&e, g->intervalo_geracao);
+    escrever_int(&e, g->max_modulos);
+    // Relógios gravados como ticks já decorridos, derivados dos prazos na roda
+    int ticks_geracao = temporizador_restante(&g->roda, TEMPORIZADOR_GERACAO);
+    ticks_geracao = ticks_geracao >= 0 ? g->intervalo_geracao - ticks_geracao : 0;
+    escrever_int(&e, ticks_geracao > 0 ? ticks_geracao : 0);
+    escrever_int(&e, TICKS_POR_SEGUNDO - temporizador_restante(&g->roda, TEMPORIZADOR_RELOGIO));
+    escrever_int(&e, g->erros_cometidos);
+    escrever_u32(&e, g->semente);
+    escrever_u32(&e, g->estado_rng);
+    escrever_u32(&e, g->proximo_ticket_espera);
+    escrever_u32(&e, g->bancadas_livres);
+
+    for (int i = 0; i < g->qtd_tedax; i++) {
+        const Tedax *t = &g->tedax[i];
+        escrever_int(&e, t->estado);
+        escrever_int(&e, t->modulo_atual);
+        escrever_int(&e, t->bancada_atual);
+        escrever_int(&e, t->capacidade_fila);
+        escrever_int(&e, t->qtd_fila);
+        for (int k = 0; k < t->qtd_fila; k++) {
+            const ItemFilaTedax *item = &t->fila[(t->inicio_fila + k) % MAX_FILA_TEDAX];
+            escrever_int(&e, item->modulo_idx);
+            escrever_int(&e, item->bancada_idx);
+        }
+    }
+
+    for (int i = 0; i < g->qtd_bancadas; i++) {
+        const Bancada *b = &g->bancadas[i];
+        escrever_int(&e, b->estado);
+        escrever_int(&e, b->tedax_ocupando);
+        escrever_fila_espera(&e, &b->espera);
+    }
+    escrever_fila_espera(&e, &g->espera_global);
+
+    escrever_int(&e, g->qtd_modulos);
+    for (int i = 0; i < g->qtd_modulos; i++) {
+        escrever_modulo(&e, g, i);
+    }
+
+    if (e.ok) {
+        escrever_u32(&e, fnv1a(buffer, e.pos));
+    }
+    return e.ok ? e.pos : 0;
+}
+
+// ---------- Leitura ----------
+
+static void ler_bytes(Leitor *l, void *destino, size_t n) {
+    if (!l->ok || l->pos + n > l->tamanho) {
+        l->ok = 0;
+        memset(destino, 0, n);
+        return;
+    }
+    memcpy(destino, l->dados + l->pos, n);
+    l->pos += n;
+}
+
+static uint32_t ler_u32(Leitor *l) {
+    unsigned char b[4];
+    ler_bytes(l, b, 4);
+    return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+
+// Lê um inteiro e invalida a leitura se estiver fora de [minimo, maximo]
+static int ler_int(Leitor *l, int minimo, int maximo) {
+    int v = (int)ler_u32(l);
+    if (v < minimo || v > maximo) {
+        l->ok = 0;
+        return minimo;
+    }
+    return v;
+}
+
+static void ler_texto(Leitor *l, char *destino, size_t capacidade) {
+    unsigned char len = 0;
+    ler_bytes(l, &len, 1);
+    if (len >= capacidade) {
+        l->ok = 0;
+        len = 0;
+    }
+    ler_bytes(l, destino, len);
+    destino[len] = '\0';
+}
+
+static void ler_fila_espera(Leitor *l, FilaEspera *f, int qtd_tedax) {
+    f->inicio = 0;
+    f->qtd = ler_int(l, 0, qtd_tedax);
+    for (int k = 0; k < f->qtd; k++) {
+        f->tedax_ids[k] = ler_int(l, 1, qtd_tedax);
+        f->tickets[k] = ler_u32(l);
+    }
+}
+
+// Relógios do módulo vão para `tempo_restante` e `desde`; viram prazos na roda depois de validados
+static void ler_modulo(Leitor *l, GameState *g, int i, int *tempo_restante, int *desde) {
+    Modulo *mod = &g->modulos[i];
+    memset(mod, 0, sizeof(*mod));
+    g->quente.id[i] = ler_int(l, 1, 1 << 30);
+    mod->tipo = (TipoModulo)ler_int(l, TIPO_BOTAO, TIPO_FIOS);
+    g->quente.estado[i] = (unsigned char)ler_int(l, MOD_PENDENTE, MOD_RESOLVIDO);
+    mod->tempo_total = ler_int(l, 0, 1 << 20);
+    *tempo_restante = ler_int(l, -1, 1 << 20);
+    *desde = ler_int(l, -1, 1 << 30);
+    g->quente.reservado[i] = (unsigned char)ler_int(l, 0, 1);
+    if (l->versao >= 2) {
+        mod->criado_em = ler_int(l, 0, 1 << 24);
+        mod->tempo_solucao = ler_int(l, -1, 1 << 24);
+    } else {
+        mod->criado_em = 0;
+        mod->tempo_solucao = -1;
+    }
+    mod->atribuido_no_tick = -1;
+    mod->espera_inicio = -1;
+    ler_texto(l, mod->instrucao_correta, sizeof(mod->instrucao_correta));
+    ler_texto(l, mod->instrucao_digitada, sizeof(mod->instrucao_digitada));
+
+    switch (mod->tipo) {
+        case TIPO_BOTAO:
+            mod->dados.botao.cor = (CorBotao)ler_int(l, COR_VERMELHO, COR_AZUL);
+            break;
+        case TIPO_SENHA:
+            ler_texto(l, mod->dados.senha.hash, sizeof(mod->dados.senha.hash));
+            ler_texto(l, mod->dados.senha.senha_correta, sizeof(mod->dados.senha.senha_correta));
+            break;
+        case TIPO_FIOS:
+            ler_texto(l, mod->dados.fios.sequencia, sizeof(mod->dados.fios.sequencia));
+            mod->dados.fios.padrao = ler_int(l, 0, 4);
+            ler_texto(l, mod->dados.fios.instrucao_correta, sizeof(mod->dados.fios.instrucao_correta));
+            break;
+    }
+}
+
+// Tedax, bancadas e filas de espera precisam contar a mesma história: bancada ocupada pelo
+// tedax ocupado que aponta para ela, e cada tedax esperando em exatamente uma fila (a da
+// bancada dele ou a global), sem ninguém mais nas filas
+static int ocupacao_consistente(const GameState *g) {
+    for (int i = 0; i < g->qtd_bancadas; i++) {
+        const Bancada *b = &g->bancadas[i];
+        if (b->estado == BANCADA_LIVRE) {
+            if (b->tedax_ocupando != -1) {
+                return 0;
+            }
+            continue;
+        }
+        if (b->tedax_ocupando < 1) {
+            return 0;
+        }
+        const Tedax *t = &g->tedax[b->tedax_ocupando - 1];
+        if (t->estado != TEDAX_OCUPADO || t->bancada_atual != i) {
+            return 0;
+        }
+    }
+
+    int aparicoes[MAX_TEDAX] = {0};
+    for (int i = 0; i <= g->qtd_bancadas; i++) {
+        const FilaEspera *f = (i < g->qtd_bancadas) ? &g->bancadas[i].espera : &g->espera_global;
+        int bancada_da_fila = (i < g->qtd_bancadas) ? i : -1;
+        for (int k = 0; k < f->qtd; k++) {
+            const Tedax *t = &g->tedax[f->tedax_ids[k] - 1];
+            if (t->estado != TEDAX_ESPERANDO || t->bancada_atual != bancada_da_fila) {
+                return 0;
+            }
+            aparicoes[f->tedax_ids[k] - 1]++;
+        }
+    }
+
+    for (int i = 0; i < g->qtd_tedax; i++) {
+        const Tedax *t = &g->tedax[i];
+        if (t->estado == TEDAX_OCUPADO) {
+            if (t->modulo_atual < 0 || t->bancada_atual < 0 ||
+                g->bancadas[t->bancada_atual].tedax_ocupando != t->id) {
+                return 0;
+            }
+        }
+        if (aparicoes[i] != (t->estado == TEDAX_ESPERANDO)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Confere assinatura, versão e checksum; retorna o leitor posicionado após a versão
+static int abrir_retrato(const unsigned char *dados, size_t tamanho, Leitor *l) {
+    if (tamanho < 12 || memcmp(dados, "TDXS", 4) != 0) {
+        falhar("arquivo nao e um salvamento de partida");
+        return 0;
+    }
+    int versao = dados[4] | (dados[5] << 8);
+    if (versao < 1 || versao > VERSAO_SALVAMENTO) {
+        snprintf(mensagem_erro_salvamento, sizeof(mensagem_erro_salvamento),
+                 "versao de salvamento %d nao suportada (esperada %d)", versao, VERSAO_SALVAMENTO);
+        return 0;
+    }
+    Leitor fim = { dados, tamanho - 4, tamanho, 1, versao };
+    if (ler_u32(&fim) != fnv1a(dados, tamanho - 4)) {
+        falhar("salvamento corrompido (checksum)");
+        return 0;
+    }
+    l->dados = dados;
+    l->pos = 8;
+    l->tamanho = tamanho - 4;
+    l->ok = 1;
+    l->versao = versao;
+    return 1;
+}
+
+int ler_cabecalho_partida(const unsigned char *dados, size_t tamanho,
+                          Dificuldade *dificuldade, int *num_tedax, int *num_bancadas) {
+    Leitor l;
+    if (!abrir_retrato(dados, tamanho, &l)) {
+        return 0;
+    }
+    *dificuldade = (Dificuldade)ler_int(&l, DIFICULDADE_FACIL, DIFICULDADE_CUSTOM);
+    *num_tedax = ler_int(&l, 1, MAX_TEDAX);
+    *num_bancadas = ler_int(&l, 1, MAX_BANCADAS);
+    if (!l.ok) {
+        falhar("cabecalho de salvamento invalido");
+    }
+    return l.ok;
+}
+
+int restaurar_partida(GameState *g, const unsigned char *dados, size_t tamanho) {
+    Leitor l;
+    if (!abrir_retrato(dados, tamanho, &l)) {
+        return 0;
+    }
+
+    // Decodifica numa cópia; só depois de tudo validado o estado vivo é trocado
+    GameState *novo = malloc(sizeof(GameState));
+    if (!novo) {
+        falhar("sem memoria");
+        return 0;
+    }
+
+    novo->dificuldade = (Dificuldade)ler_int(&l, DIFICULDADE_FACIL, DIFICULDADE_CUSTOM);
+    novo->qtd_tedax = ler_int(&l, 1, MAX_TEDAX);
+    novo->qtd_bancadas = ler_int(&l, 1, MAX_BANCADAS);
+    if (l.ok && (novo->qtd_tedax != g->qtd_tedax || novo->qtd_bancadas != g->qtd_bancadas)) {
+        falhar("salvamento tem outro numero de tedax/bancadas");
+        free(novo);
+        return 0;
+    }
+    novo->tempo_total_partida = ler_int(&l, 1, 1 << 24);
+    novo->tempo_restante = ler_int(&l, 0, 1 << 24);
+    novo->proximo_id_modulo = ler_int(&l, 1, 1 << 30);
+    novo->modulos_necessarios = ler_int(&l, 1, MAX_MODULOS);
+    novo->intervalo_geracao = ler_int(&l, 1, 1 << 20);
+    novo->max_modulos = ler_int(&l, 1, MAX_MODULOS);
+    int ticks_geracao = ler_int(&l, 0, 1 << 20);
+    int ticks_relogio = ler_int(&l, 0, TICKS_POR_SEGUNDO - 1);
+    novo->erros_cometidos = ler_int(&l, 0, 1 << 20);
+    novo->semente = ler_u32(&l);
+    novo->estado_rng = ler_u32(&l);
+    novo->proximo_ticket_espera = ler_u32(&l);
+    ler_u32(&l);    // bancadas_livres: refeito a partir do estado de cada bancada
+
+    for (int i = 0; i < novo->qtd_tedax; i++) {
+        Tedax *t = &novo->tedax[i];
+        t->id = i + 1;
+        t->estado = (EstadoTedax)ler_int(&l, TEDAX_LIVRE, TEDAX_ESPERANDO);
+        t->modulo_atual = ler_int(&l, -1, MAX_MODULOS - 1);
+        t->bancada_atual = ler_int(&l, -1, novo->qtd_bancadas - 1);
+        t->capacidade_fila = ler_int(&l, 1, MAX_FILA_TEDAX);
+        t->qtd_fila = ler_int(&l, 0, t->capacidade_fila);
+        t->inicio_fila = 0;
+        for (int k = 0; k < t->qtd_fila; k++) {
+            t->fila[k].modulo_idx = ler_int(&l, 0, MAX_MODULOS - 1);
+            t->fila[k].bancada_idx = ler_int(&l, -1, novo->qtd_bancadas - 1);
+        }
+    }
+
+    for (int i = 0; i < novo->qtd_bancadas; i++) {
+        Bancada *b = &novo->bancadas[i];
+        b->id = i + 1;
+        b->estado = (EstadoBancada)ler_int(&l, BANCADA_LIVRE, BANCADA_OCUPADA);
+        b->tedax_ocupando = ler_int(&l, -1, novo->qtd_tedax);
+        ler_fila_espera(&l, &b->espera, novo->qtd_tedax);
+    }
+    ler_fila_espera(&l, &novo->espera_global, novo->qtd_tedax);
+
+    novo->qtd_modulos = ler_int(&l, 0, MAX_MODULOS);
+    int tempo_restante[MAX_MODULOS];
+    int desde_resolvido[MAX_MODULOS];
+    for (int i = 0; i < novo->qtd_modulos; i++) {
+        ler_modulo(&l, novo, i, &tempo_restante[i], &desde_resolvido[i]);
+    }
+
+    // Referências a módulos precisam apontar para módulos existentes
+    for (int i = 0; l.ok && i < novo->qtd_tedax; i++) {
+        const Tedax *t = &novo->tedax[i];
+        if (t->modulo_atual >= novo->qtd_modulos) {
+            l.ok = 0;
+        }
+        for (int k = 0; k < t->qtd_fila; k++) {
+            if (t->fila[k].modulo_idx >= novo->qtd_modulos) {
+                l.ok = 0;
+            }
+        }
+    }
+    if (!l.ok || l.pos != l.tamanho) {
+        falhar("salvamento invalido ou truncado");
+        free(novo);
+        return 0;
+    }
+    if (!ocupacao_consistente(novo)) {
+        falhar("salvamento com tedax e bancadas inconsistentes");
+        free(novo);
+        return 0;
+    }
+    novo->bancadas_livres = 0;
+    for (int i = 0; i < novo->qtd_bancadas; i++) {
+        if (novo->bancadas[i].estado == BANCADA_LIVRE) {
+            novo->bancadas_livres |= 1u << i;
+        }
+    }
+
+    // Prazos voltam para a roda a partir dos relógios gravados
+    temporizador_inicializar(&novo->roda);
+    temporizador_agendar(&novo->roda, TEMPORIZADOR_RELOGIO, TICKS_POR_SEGUNDO - ticks_relogio);
+    if (novo->qtd_modulos < novo->max_modulos) {
+        temporizador_agendar(&novo->roda, TEMPORIZADOR_GERACAO, novo->intervalo_geracao - ticks_geracao);
+    }
+    for (int i = 0; i < novo->qtd_tedax; i++) {
+        const Tedax *t = &novo->tedax[i];
+        int m = t->modulo_atual;
+        if (t->estado == TEDAX_OCUPADO && m >= 0 && novo->quente.estado[m] == MOD_EM_EXECUCAO &&
+            novo->modulos[m].instrucao_digitada[0] != '\0') {
+            int segundos = tempo_restante[m] > 0 ? tempo_restante[m] : novo->modulos[m].tempo_total;
+            temporizador_agendar(&novo->roda, TEMPORIZADOR_TEDAX(i), segundos * TICKS_POR_SEGUNDO);
+        }
+    }
+    for (int m = 0; m < novo->qtd_modulos; m++) {
+        if (novo->quente.estado[m] == MOD_RESOLVIDO && desde_resolvido[m] >= 0 &&
+            desde_resolvido[m] < SEGUNDOS_RESOLVIDO_VISIVEL) {
+            temporizador_agendar(&novo->roda, TEMPORIZADOR_RESOLVIDO(m),
+                                 (SEGUNDOS_RESOLVIDO_VISIVEL - desde_resolvido[m]) * TICKS_POR_SEGUNDO);
+        }
+    }
+
+    // Troca só os dados; mutex, condições e threads da partida viva são mantidos
+    g->dificuldade = novo->dificuldade;
+    g->tempo_total_partida = novo->tempo_total_partida;
+    g->tempo_restante = novo->tempo_restante;
+    memcpy(g->modulos, novo->modulos, sizeof(Modulo) * (size_t)novo->qtd_modulos);
+    g->quente = novo->quente;
+    g->qtd_modulos = novo->qtd_modulos;
+    recontar_pendentes_livres(g);
+    g->proximo_id_modulo = novo->proximo_id_modulo;
+    g->modulos_necessarios = novo->modulos_necessarios;
+    for (int i = 0; i < g->qtd_tedax; i++) {
+        Tedax *t = &g->tedax[i];
+        const Tedax *s = &novo->tedax[i];
+        t->estado = s->estado;
+        t->modulo_atual = s->modulo_atual;
+        t->bancada_atual = s->bancada_atual;
+        t->capacidade_fila = s->capacidade_fila;
+        t->inicio_fila = 0;
+        t->qtd_fila = s->qtd_fila;
+        memcpy(t->fila, s->fila, sizeof(t->fila));
+        t->prazo_vencido = 0;
+    }
+    for (int i = 0; i < g->qtd_bancadas; i++) {
+        g->bancadas[i].estado = novo->bancadas[i].estado;
+        g->bancadas[i].tedax_ocupando = novo->bancadas[i].tedax_ocupando;
+        g->bancadas[i].espera = novo->bancadas[i].espera;
+    }
+    g->bancadas_livres = novo->bancadas_livres;
+    g->espera_global = novo->espera_global;
+    g->proximo_ticket_espera = novo->proximo_ticket_espera;
+    g->semente = novo->semente;
+    g->estado_rng = novo->estado_rng;
+    g->roda = novo->roda;
+    g->versao_mural++;
+    g->geracao_pendente = 0;
+    g->intervalo_geracao = novo->intervalo_geracao;
+    g->max_modulos = novo->max_modulos;
+    g->erros_cometidos = novo->erros_cometidos;
+    // jogo_rodando/jogo_terminou ficam como estão: restaurar não revive partida já encerrada
+    g->mensagem_erro[0] = '\0';
+    free(novo);
+    
+    // Módulos em estoque vieram do gerador antigo: a produção recomeça do restaurado
+    descartar_estoque_modulos(g);
+
+    // Threads dos tedax reavaliam o módulo ativo; esperas por bancada também
+    for (int i = 0; i < g->qtd_tedax; i++) {
+        pthread_cond_signal(&g->tedax[i].cond_trabalho);
+    }
+    pthread_cond_broadcast(&g->cond_bancada_disponivel);
+    pthread_cond_broadcast(&g->cond_modulo_disponivel);
+    return 1;
+}
+
+// ---------- Arquivo ----------
+
+int gravar_arquivo_partida(const char *caminho, const unsigned char *dados, size_t tamanho) {
+    char temporario[512];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", caminho);
+
+    FILE *f = fopen(temporario, "wb");
+    if (!f) {
+        falhar("nao foi possivel criar o arquivo");
+        return 0;
+    }
+    int ok = fwrite(dados, 1, tamanho, f) == tamanho;
+    ok = (fclose(f) == 0) && ok;
+    if (!ok || rename(temporario, caminho) != 0) {
+        remove(temporario);
+        falhar("falha ao gravar o salvamento");
+        return 0;
+    }
+    return 1;
+}
+
+unsigned char* ler_arquivo_partida(const char *caminho, size_t *tamanho) {
+    FILE *f = fopen(caminho, "rb");
+    if (!f) {
+        snprintf(mensagem_erro_salvamento, sizeof(mensagem_erro_salvamento), "%s: nao foi possivel abrir", caminho);
+        return NULL;
+    }
+    unsigned char *dados = malloc(TAMANHO_MAX_SALVAMENTO);
+    size_t lidos = dados ? fread(dados, 1, TAMANHO_MAX_SALVAMENTO, f) : 0;
+    fclose(f);
+    if (!dados || lidos == 0 || lidos == TAMANHO_MAX_SALVAMENTO) {
+        free(dados);
+        snprintf(mensagem_erro_salvamento, sizeof(mensagem_erro_salvamento), "%s: tamanho invalido", caminho);
+        return NULL;
+    }
+    *tamanho = lidos;
+    return dados;
+}
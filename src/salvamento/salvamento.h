@@ -0,0 +1,36 @@
+#ifndef SALVAMENTO_H
+#define SALVAMENTO_H
+
+#include <stddef.h>
+#include "../game/game.h"
+
+// Retrato binário versionado de uma partida em andamento: módulos, filas dos tedax,
+// esperas das bancadas, relógios e estado do gerador. Mutex, condições e threads não
+// entram no arquivo; são os da partida em que o retrato é restaurado.
+//
+// Formato (inteiros little-endian):
+//   "TDXS" | versão u16 | reservado u16 | partida | tedax | bancadas | espera geral | módulos | FNV-1a u32
+
+#define ARQUIVO_SALVAMENTO "partida.sav"
+#define VERSAO_SALVAMENTO 2         // 2: criado_em/tempo_solucao dos módulos (1 ainda é lido)
+#define TAMANHO_MAX_SALVAMENTO 32768
+
+// Com mutex_jogo travado. Retorna o tamanho escrito ou 0 se não couber.
+size_t serializar_partida(const GameState *g, unsigned char *buffer, size_t tamanho);
+
+// Lê só o necessário para inicializar a partida que vai receber o retrato
+int ler_cabecalho_partida(const unsigned char *dados, size_t tamanho,
+                          Dificuldade *dificuldade, int *num_tedax, int *num_bancadas);
+
+// Com mutex_jogo travado, sobre uma partida inicializada com as mesmas dimensões.
+// Em caso de erro a partida não é alterada.
+int restaurar_partida(GameState *g, const unsigned char *dados, size_t tamanho);
+
+// Escrita atômica (arquivo temporário + rename) e leitura completa (malloc)
+int gravar_arquivo_partida(const char *caminho, const unsigned char *dados, size_t tamanho);
+unsigned char* ler_arquivo_partida(const char *caminho, size_t *tamanho);
+
+// Motivo da última falha de leitura/restauração
+const char* erro_salvamento(void);
+
+#endif // SALVAMENTO_H
@@ -0,0 +1,424 @@
+#define _GNU_SOURCE
+#include "servidor.h"
+#include "../game/game.h"
+#include "../fases/fases.h"
+#include "../protocolo/protocolo.h"
+#include "../pool/pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+#define TAMANHO_SAIDA_SESSAO (TAMANHO_QUADRO_PROTOCOLO * 2)
+
+typedef struct Sessao {
+    int fd;
+    int iniciada;               // Já recebeu JOGAR e tem partida em andamento
+    atomic_int em_fila;         // Tick enviado ao pool e ainda não terminado
+    atomic_int encerrar;        // Cliente saiu ou partida terminou
+    int fechar_apos_envio;      // Partida terminou: fecha quando a saída esvaziar
+    int entrada_fechada;        // Cliente fechou o lado de escrita: não espera mais EPOLLIN
+
+    GameState g;
+
+    char entrada[256];
+    size_t len_entrada;
+
+    // Saída pendente (cliente lento): protegida por g.mutex_jogo
+    char saida[TAMANHO_SAIDA_SESSAO];
+    size_t len_saida;
+
+    struct Sessao *prox;
+} Sessao;
+
+static int epoll_fd = -1;
+static PoolThreads *pool = NULL;
+static Sessao *sessoes = NULL;
+static int qtd_sessoes = 0;
+
+// Tenta enviar a saída pendente; pede EPOLLOUT se o cliente não aceitou tudo (mutex_jogo travado)
+static void descarregar_saida(Sessao *s) {
+    while (s->len_saida > 0) {
+        ssize_t n = send(s->fd, s->saida, s->len_saida, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            // EPIPE/ECONNRESET e afins: o cliente não lê mais, nada do pendente chega
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                atomic_store(&s->encerrar, 1);
+                s->len_saida = 0;
+            }
+            break;
+        }
+        memmove(s->saida, s->saida + n, s->len_saida - (size_t)n);
+        s->len_saida -= (size_t)n;
+    }
+
+    struct epoll_event ev = { .events = s->entrada_fechada ? 0 : EPOLLIN, .data.ptr = s };
+    if (s->len_saida > 0) {
+        ev.events |= EPOLLOUT;
+    } else if (s->fechar_apos_envio) {
+        shutdown(s->fd, SHUT_WR);
+    }
+    epoll_ctl(epoll_fd, EPOLL_CTL_MOD, s->fd, &ev);
+}
+
+// Enfileira bytes na saída da sessão; quadros são descartados se o cliente estiver atrasado
+static void enviar(Sessao *s, const char *dados, size_t tamanho, int descartavel) {
+    if (descartavel && s->len_saida > 0) {
+        return;
+    }
+    if (s->len_saida + tamanho > sizeof(s->saida)) {
+        return;
+    }
+    memcpy(s->saida + s->len_saida, dados, tamanho);
+    s->len_saida += tamanho;
+    descarregar_saida(s);
+}
+
+// Tarefa do pool: um tick da sessão e o quadro resultante
+static void tarefa_tick_sessao(void *arg) {
+    Sessao *s = (Sessao*)arg;
+    char quadro[TAMANHO_QUADRO_PROTOCOLO];
+
+    pthread_mutex_lock(&s->g.mutex_jogo);
+    if (!atomic_load(&s->encerrar)) {
+        int terminou = avancar_tick_partida(&s->g);
+        size_t n = protocolo_escrever_quadro(&s->g, quadro, sizeof(quadro));
+        enviar(s, quadro, n, 1);
+        if (terminou) {
+            n = protocolo_escrever_fim(&s->g, quadro, sizeof(quadro));
+            enviar(s, quadro, n, 0);
+            s->fechar_apos_envio = 1;
+            atomic_store(&s->encerrar, 1);
+            descarregar_saida(s);
+        }
+    }
+    pthread_mutex_unlock(&s->g.mutex_jogo);
+
+    atomic_store(&s->em_fila, 0);
+}
+
+// Um tick por sessão em jogo; quem ainda não terminou o anterior (em_fila) pula este
+static void agendar_ticks(void) {
+    for (Sessao *s = sessoes; s; s = s->prox) {
+        if (!s->iniciada || atomic_load(&s->encerrar) || atomic_load(&s->em_fila)) {
+            continue;
+        }
+        atomic_store(&s->em_fila, 1);
+        pool_enviar(pool, tarefa_tick_sessao, s);
+    }
+}
+
+// Libera sessões encerradas que nenhum worker está usando. Cliente que já fechou o lado
+// dele leva só o que coube no socket: a saída pendente é descartada em vez de segurar a sessão
+static void recolher_sessoes(void) {
+    Sessao **ref = &sessoes;
+    while (*ref) {
+        Sessao *s = *ref;
+        if (atomic_load(&s->encerrar) && s->entrada_fechada && s->len_saida > 0) {
+            pthread_mutex_lock(&s->g.mutex_jogo);
+            descarregar_saida(s);
+            s->len_saida = 0;
+            pthread_mutex_unlock(&s->g.mutex_jogo);
+        }
+        int pode_liberar = atomic_load(&s->encerrar) && !atomic_load(&s->em_fila) &&
+                           s->len_saida == 0;
+        if (!pode_liberar) {
+            ref = &s->prox;
+            continue;
+        }
+        *ref = s->prox;
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, s->fd, NULL);
+        close(s->fd);
+        if (s->iniciada) {
+            finalizar_jogo(&s->g);
+        } else {
+            pthread_mutex_destroy(&s->g.mutex_jogo);
+        }
+        free(s);
+        qtd_sessoes--;
+    }
+}
+
+static void aceitar_cliente(int fd_escuta) {
+    while (1) {
+        int fd = accept4(fd_escuta, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        if (qtd_sessoes >= MAX_SESSOES) {
+            const char *msg = "ERRO Servidor cheio\n";
+            send(fd, msg, strlen(msg), MSG_NOSIGNAL);
+            close(fd);
+            continue;
+        }
+        Sessao *s = calloc(1, sizeof(Sessao));
+        if (!s) {
+            close(fd);
+            continue;
+        }
+        s->fd = fd;
+        // Mutex próprio até a partida começar (inicializar_jogo o reinicializa)
+        pthread_mutex_init(&s->g.mutex_jogo, NULL);
+        s->prox = sessoes;
+        sessoes = s;
+        qtd_sessoes++;
+
+        struct epoll_event ev = { .events = EPOLLIN, .data.ptr = s };
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+    }
+}
+
+static void processar_linha_cliente(Sessao *s, const char *linha) {
+    char resposta[128];
+
+    if (!s->iniciada) {
+        Dificuldade dificuldade;
+        if (strncmp(linha, "JOGAR ", 6) != 0 || !protocolo_dificuldade_por_nome(linha + 6, &dificuldade)) {
+            const char *erro = "ERRO Esperado JOGAR <facil|medio|dificil|custom>\n";
+            pthread_mutex_lock(&s->g.mutex_jogo);
+            enviar(s, erro, strlen(erro), 0);
+            pthread_mutex_unlock(&s->g.mutex_jogo);
+            return;
+        }
+        pthread_mutex_destroy(&s->g.mutex_jogo);
+        ConfigFase config = obter_config_fase(dificuldade);
+        inicializar_jogo(&s->g, dificuldade, config.num_tedax, config.num_bancadas);
+        s->iniciada = 1;
+        pthread_mutex_lock(&s->g.mutex_jogo);
+        enviar(s, "OK\n", 3, 0);
+        pthread_mutex_unlock(&s->g.mutex_jogo);
+        return;
+    }
+
+    pthread_mutex_lock(&s->g.mutex_jogo);
+    size_t n = protocolo_processar_linha(&s->g, linha, resposta, sizeof(resposta), 0);
+    enviar(s, resposta, n, 0);
+    pthread_mutex_unlock(&s->g.mutex_jogo);
+}
+
+static void ler_cliente(Sessao *s) {
+    char buffer[512];
+    while (1) {
+        ssize_t n = recv(s->fd, buffer, sizeof(buffer), 0);
+        if (n == 0) {
+            // Fim da entrada: ainda entrega o que estiver pendente (ex.: FIM) antes de fechar
+            atomic_store(&s->encerrar, 1);
+            pthread_mutex_lock(&s->g.mutex_jogo);
+            s->entrada_fechada = 1;
+            s->fechar_apos_envio = 1;
+            descarregar_saida(s);
+            pthread_mutex_unlock(&s->g.mutex_jogo);
+            return;
+        }
+        if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            atomic_store(&s->encerrar, 1);
+            pthread_mutex_lock(&s->g.mutex_jogo);
+            s->len_saida = 0;
+            pthread_mutex_unlock(&s->g.mutex_jogo);
+            return;
+        }
+        if (n < 0) {
+            return;
+        }
+        for (ssize_t i = 0; i < n; i++) {
+            char c = buffer[i];
+            if (c == '\r') {
+                continue;
+            }
+            if (c != '\n') {
+                if (s->len_entrada < sizeof(s->entrada) - 1) {
+                    s->entrada[s->len_entrada++] = c;
+                }
+                continue;
+            }
+            s->entrada[s->len_entrada] = '\0';
+            s->len_entrada = 0;
+            if (s->entrada[0] != '\0' && !atomic_load(&s->encerrar)) {
+                processar_linha_cliente(s, s->entrada);
+            }
+        }
+    }
+}
+
+static volatile sig_atomic_t servidor_rodando = 1;
+
+static void tratar_sinal(int sinal) {
+    (void)sinal;
+    servidor_rodando = 0;
+}
+
+int executar_servidor(const char *caminho_socket, int num_workers) {
+    if (num_workers < 1) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_workers = cpus > 0 ? (int)cpus : 2;
+    }
+
+    int fd_escuta = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd_escuta < 0) {
+        perror("socket");
+        return 1;
+    }
+    struct sockaddr_un endereco;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    strncpy(endereco.sun_path, caminho_socket, sizeof(endereco.sun_path) - 1);
+    unlink(caminho_socket);
+    if (bind(fd_escuta, (struct sockaddr*)&endereco, sizeof(endereco)) < 0 || listen(fd_escuta, 64) < 0) {
+        perror("bind/listen");
+        close(fd_escuta);
+        return 1;
+    }
+
+    int fd_timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    struct itimerspec periodo = {
+        .it_interval = { .tv_sec = 0, .tv_nsec = 200000000L },
+        .it_value = { .tv_sec = 0, .tv_nsec = 200000000L }
+    };
+    timerfd_settime(fd_timer, 0, &periodo, NULL);
+
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event ev_escuta = { .events = EPOLLIN, .data.ptr = &fd_escuta };
+    struct epoll_event ev_timer = { .events = EPOLLIN, .data.ptr = &fd_timer };
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd_escuta, &ev_escuta);
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd_timer, &ev_timer);
+
+    signal(SIGINT, tratar_sinal);
+    signal(SIGTERM, tratar_sinal);
+    signal(SIGPIPE, SIG_IGN);
+
+    pool = pool_criar(num_workers);
+    if (!pool) {
+        fprintf(stderr, "Erro: nao foi possivel criar o pool com %d worker(s)\n", num_workers);
+        close(epoll_fd);
+        close(fd_timer);
+        close(fd_escuta);
+        unlink(caminho_socket);
+        return 1;
+    }
+
+    fprintf(stderr, "Servidor em %s (%d workers)\n", caminho_socket, pool_qtd_workers(pool));
+
+    struct epoll_event eventos[64];
+    while (servidor_rodando) {
+        int recolher = 0;
+        int n = epoll_wait(epoll_fd, eventos, 64, 1000);
+        for (int i = 0; i < n; i++) {
+            void *ptr = eventos[i].data.ptr;
+            if (ptr == &fd_escuta) {
+                aceitar_cliente(fd_escuta);
+            } else if (ptr == &fd_timer) {
+                unsigned long long expiracoes;
+                if (read(fd_timer, &expiracoes, sizeof(expiracoes)) > 0) {
+                    agendar_ticks();
+                    recolher = 1;
+                }
+            } else {
+                Sessao *s = (Sessao*)ptr;
+                if (eventos[i].events & EPOLLOUT) {
+                    pthread_mutex_lock(&s->g.mutex_jogo);
+                    descarregar_saida(s);
+                    pthread_mutex_unlock(&s->g.mutex_jogo);
+                }
+                if (eventos[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                    ler_cliente(s);
+                }
+                // Conexão desfeita nos dois sentidos: a saída pendente não tem para onde ir
+                if (eventos[i].events & (EPOLLHUP | EPOLLERR)) {
+                    atomic_store(&s->encerrar, 1);
+                    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, s->fd, NULL);
+                    pthread_mutex_lock(&s->g.mutex_jogo);
+                    s->entrada_fechada = 1;
+                    s->len_saida = 0;
+                    pthread_mutex_unlock(&s->g.mutex_jogo);
+                }
+            }
+        }
+        // Só depois do lote: eventos seguintes ainda podem apontar para a sessão
+        if (recolher) {
+            recolher_sessoes();
+        }
+    }
+
+    // Encerramento: espera os ticks em andamento, para os workers e descarta todas as sessões
+    pool_destruir(pool);
+    pool = NULL;
+
+    for (Sessao *s = sessoes; s; s = s->prox) {
+        atomic_store(&s->encerrar, 1);
+        s->len_saida = 0;
+    }
+    recolher_sessoes();
+
+    close(fd_timer);
+    close(fd_escuta);
+    close(epoll_fd);
+    unlink(caminho_socket);
+    return 0;
+}
+
+int executar_cliente(const char *caminho_socket, const char *dificuldade) {
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    struct sockaddr_un endereco;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    strncpy(endereco.sun_path, caminho_socket, sizeof(endereco.sun_path) - 1);
+    if (fd < 0 || connect(fd, (struct sockaddr*)&endereco, sizeof(endereco)) < 0) {
+        perror("connect");
+        return 1;
+    }
+
+    char buffer[4096];
+    int n = snprintf(buffer, sizeof(buffer), "JOGAR %s\n", dificuldade);
+    if (write(fd, buffer, (size_t)n) < 0) {
+        close(fd);
+        return 1;
+    }
+
+    // Em terminal, cada quadro começa com a tela limpa
+    int limpar_tela = isatty(STDOUT_FILENO);
+    int stdin_aberto = 1;
+    struct pollfd fds[2] = {
+        { .fd = fd, .events = POLLIN },
+        { .fd = STDIN_FILENO, .events = POLLIN }
+    };
+
+    while (1) {
+        if (poll(fds, stdin_aberto ? 2 : 1, -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[0].revents) {
+            ssize_t lidos = read(fd, buffer, sizeof(buffer));
+            if (lidos <= 0) {
+                break;
+            }
+            if (limpar_tela && lidos >= 6 && strncmp(buffer, "ESTADO", 6) == 0) {
+                fputs("\033[H\033[2J", stdout);
+            }
+            fwrite(buffer, 1, (size_t)lidos, stdout);
+            fflush(stdout);
+        }
+        if (stdin_aberto && fds[1].revents) {
+            ssize_t lidos = read(STDIN_FILENO, buffer, sizeof(buffer));
+            if (lidos <= 0) {
+                stdin_aberto = 0;
+                shutdown(fd, SHUT_WR);
+            } else if (write(fd, buffer, (size_t)lidos) < 0) {
+                break;
+            }
+        }
+    }
+
+    close(fd);
+    return 0;
+}
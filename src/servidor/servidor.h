@@ -0,0 +1,17 @@
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+// Servidor multi-sessão: várias partidas independentes em um processo, atendidas por
+// um laço epoll e o pool de src/pool, que avança os ticks de todas as sessões.
+// Cada conexão envia "JOGAR <facil|medio|dificil|custom>" e depois fala o protocolo
+// de linhas de src/protocolo (comandos na entrada, quadros e respostas na saída).
+
+#define SOCKET_PADRAO "/tmp/tedax_jogo.sock"
+#define MAX_SESSOES 256
+
+int executar_servidor(const char *caminho_socket, int num_workers);
+
+// Cliente fino: repassa stdin ao servidor e imprime os quadros recebidos
+int executar_cliente(const char *caminho_socket, const char *dificuldade);
+
+#endif // SERVIDOR_H
@@ -0,0 +1,123 @@
+#include "temporizador.h"
+
+#define MASCARA_SLOT (TEMPORIZADOR_SLOTS - 1)
+#define ALCANCE_MAXIMO ((1 << (TEMPORIZADOR_BITS_NIVEL * TEMPORIZADOR_NIVEIS)) - 1)
+
+void temporizador_inicializar(RodaTemporizadores *r) {
+    r->agora = 0;
+    for (int n = 0; n < TEMPORIZADOR_NIVEIS; n++) {
+        for (int s = 0; s < TEMPORIZADOR_SLOTS; s++) {
+            r->cabeca[n][s] = -1;
+        }
+    }
+    for (int i = 0; i < MAX_TEMPORIZADORES; i++) {
+        r->t[i].nivel = -1;
+        r->t[i].prox = -1;
+        r->t[i].ant = -1;
+    }
+}
+
+// Coloca no nível cujo alcance cobre a distância até o vencimento; o slot vem do tick absoluto
+static void inserir(RodaTemporizadores *r, int id) {
+    Temporizador *t = &r->t[id];
+    int distancia = t->vencimento - r->agora;
+    int nivel = 0;
+    while (nivel < TEMPORIZADOR_NIVEIS - 1 &&
+           distancia >= (1 << (TEMPORIZADOR_BITS_NIVEL * (nivel + 1)))) {
+        nivel++;
+    }
+    int slot = (t->vencimento >> (TEMPORIZADOR_BITS_NIVEL * nivel)) & MASCARA_SLOT;
+
+    t->nivel = (signed char)nivel;
+    t->slot = (unsigned char)slot;
+    t->ant = -1;
+    t->prox = r->cabeca[nivel][slot];
+    if (t->prox >= 0) {
+        r->t[t->prox].ant = id;
+    }
+    r->cabeca[nivel][slot] = id;
+}
+
+static void remover(RodaTemporizadores *r, int id) {
+    Temporizador *t = &r->t[id];
+    if (t->ant >= 0) {
+        r->t[t->ant].prox = t->prox;
+    } else {
+        r->cabeca[t->nivel][t->slot] = t->prox;
+    }
+    if (t->prox >= 0) {
+        r->t[t->prox].ant = t->ant;
+    }
+    t->nivel = -1;
+    t->prox = -1;
+    t->ant = -1;
+}
+
+void temporizador_agendar(RodaTemporizadores *r, int id, int ticks) {
+    if (id < 0 || id >= MAX_TEMPORIZADORES) {
+        return;
+    }
+    if (r->t[id].nivel >= 0) {
+        remover(r, id);
+    }
+    if (ticks < 1) ticks = 1;
+    if (ticks > ALCANCE_MAXIMO) ticks = ALCANCE_MAXIMO;
+    r->t[id].vencimento = r->agora + ticks;
+    inserir(r, id);
+}
+
+void temporizador_cancelar(RodaTemporizadores *r, int id) {
+    if (id < 0 || id >= MAX_TEMPORIZADORES || r->t[id].nivel < 0) {
+        return;
+    }
+    remover(r, id);
+}
+
+int temporizador_restante(const RodaTemporizadores *r, int id) {
+    if (id < 0 || id >= MAX_TEMPORIZADORES || r->t[id].nivel < 0) {
+        return -1;
+    }
+    return r->t[id].vencimento - r->agora;
+}
+
+// Redistribui um slot de nível superior pelos níveis de baixo
+static void descer_slot(RodaTemporizadores *r, int nivel, int slot) {
+    int id = r->cabeca[nivel][slot];
+    r->cabeca[nivel][slot] = -1;
+    while (id >= 0) {
+        int prox = r->t[id].prox;
+        inserir(r, id);
+        id = prox;
+    }
+}
+
+int temporizador_avancar(RodaTemporizadores *r, int *vencidos) {
+    r->agora++;
+
+    // Ao completar uma volta do nível 0, o slot atual de cada nível de cima que também
+    // virou desce; do mais alto para o mais baixo, pois o que desce pode cair no seguinte
+    if ((r->agora & MASCARA_SLOT) == 0) {
+        int mais_alto = 1;
+        while (mais_alto + 1 < TEMPORIZADOR_NIVEIS &&
+               (r->agora & ((1 << (TEMPORIZADOR_BITS_NIVEL * (mais_alto + 1))) - 1)) == 0) {
+            mais_alto++;
+        }
+        for (int nivel = mais_alto; nivel >= 1; nivel--) {
+            descer_slot(r, nivel, (r->agora >> (TEMPORIZADOR_BITS_NIVEL * nivel)) & MASCARA_SLOT);
+        }
+    }
+
+    int qtd = 0;
+    int slot = r->agora & MASCARA_SLOT;
+    int id = r->cabeca[0][slot];
+    r->cabeca[0][slot] = -1;
+    while (id >= 0) {
+        int prox = r->t[id].prox;
+        r->t[id].nivel = -1;
+        r->t[id].prox = -1;
+        r->t[id].ant = -1;
+        vencidos[qtd++] = id;
+        id = prox;
+    }
+    return qtd;
+}
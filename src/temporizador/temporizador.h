@@ -0,0 +1,42 @@
+#ifndef TEMPORIZADOR_H
+#define TEMPORIZADOR_H
+
+// Roda de temporizadores hierárquica: cada prazo da partida é um temporizador com id fixo
+// (quem usa a roda define os ids). O nível 0 tem um slot por tick; os níveis de cima
+// cobrem 64x mais tempo por slot e descem para o nível de baixo quando a roda passa por
+// eles. Avançar um tick custa O(temporizadores que vencem ou descem de nível), não
+// O(temporizadores armados). Sem alocação: a roda inteira é um struct copiável.
+
+#define TEMPORIZADOR_BITS_NIVEL 6
+#define TEMPORIZADOR_SLOTS (1 << TEMPORIZADOR_BITS_NIVEL)
+#define TEMPORIZADOR_NIVEIS 3       // 64^3 ticks à frente
+#define MAX_TEMPORIZADORES 128
+
+typedef struct {
+    int vencimento;             // Tick absoluto em que dispara
+    int prox;                   // Lista duplamente ligada do slot (-1 = fim)
+    int ant;
+    signed char nivel;          // -1 = desarmado
+    unsigned char slot;
+} Temporizador;
+
+typedef struct {
+    int agora;                  // Ticks avançados desde temporizador_inicializar
+    int cabeca[TEMPORIZADOR_NIVEIS][TEMPORIZADOR_SLOTS];
+    Temporizador t[MAX_TEMPORIZADORES];
+} RodaTemporizadores;
+
+void temporizador_inicializar(RodaTemporizadores *r);
+
+// Arma (ou rearma) o temporizador para daqui a `ticks` ticks (mínimo 1)
+void temporizador_agendar(RodaTemporizadores *r, int id, int ticks);
+void temporizador_cancelar(RodaTemporizadores *r, int id);
+
+// Ticks até disparar, ou -1 se desarmado
+int temporizador_restante(const RodaTemporizadores *r, int id);
+
+// Avança um tick e escreve em `vencidos` os ids que dispararam (já desarmados).
+// `vencidos` precisa de espaço para MAX_TEMPORIZADORES; retorna quantos são.
+int temporizador_avancar(RodaTemporizadores *r, int *vencidos);
+
+#endif // TEMPORIZADOR_H
@@ -3,82 +3,331 @@
 #include "../game/game.h"
 #include "../modulos/modulos.h"
 #include "../audio/audio.h"
+#include "../fases/fases.h"
+#include "../ansi/ansi.h"
+#include "../comum/comum.h"
 #include <ncurses.h>
 #include <string.h>
 #include <time.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
 
-// Funções auxiliares para impressão colorida de módulos
-static void imprimir_cor_botao(CorBotao cor, int cores_disponiveis) {
-    const char* cor_nome = (cor == COR_VERMELHO) ? "Vermelho" :
-                           (cor == COR_VERDE) ? "Verde" : "Azul";
-    int pair = 0;
-    switch (cor) {
-        case COR_VERMELHO: pair = 4; break;
-        case COR_VERDE:    pair = 2; break;
-        case COR_AZUL:     pair = 5; break;
-    }
-    if (cores_disponiveis && pair > 0) {
-        attron(COLOR_PAIR(pair) | A_BOLD);
-        printw("%s", cor_nome);
-        attroff(COLOR_PAIR(pair) | A_BOLD);
+// Saída da tela da partida: ncurses (padrão) ou o renderizador ANSI próprio
+// (TEDAX_RENDERIZADOR=ansi). Menus e pós-jogo continuam sempre em ncurses.
+static int renderizador_ansi = -1;
+static int medir_quadros = 0;
+
+static int usar_ansi(void) {
+    if (renderizador_ansi < 0) {
+        const char *r = getenv("TEDAX_RENDERIZADOR");
+        renderizador_ansi = (r && strcmp(r, "ansi") == 0);
+        medir_quadros = getenv("TEDAX_MEDIR") != NULL;
+    }
+    return renderizador_ansi;
+}
+
+static void saida_limpar(void) {
+    if (usar_ansi() && ansi_iniciar(LINES, COLS)) {
+        ansi_limpar();
+    } else {
+        renderizador_ansi = 0;
+        erase();
+    }
+}
+
+static void saida_mover(int linha, int coluna) {
+    if (renderizador_ansi) {
+        ansi_mover(linha, coluna);
     } else {
-        printw("%s", cor_nome);
+        move(linha, coluna);
     }
 }
 
-static void imprimir_fio_token(const char* token, int cores_disponiveis) {
-    int pair = 0;
-    if (strcmp(token, "R") == 0) pair = 4;
-    else if (strcmp(token, "G") == 0) pair = 2;
-    else if (strcmp(token, "B") == 0) pair = 5;
-    else if (strcmp(token, "Y") == 0) pair = 3;
-    else if (strcmp(token, "W") == 0) pair = 6;
-    else if (strcmp(token, "K") == 0) pair = 7;
+static void saida_vprintf(const char *formato, va_list args) {
+    char texto[512];
+    vsnprintf(texto, sizeof(texto), formato, args);
+    if (renderizador_ansi) {
+        ansi_escrever(texto);
+    } else {
+        addstr(texto);
+    }
+}
 
-    if (cores_disponiveis && pair > 0) {
-        attron(COLOR_PAIR(pair) | A_BOLD);
-        
-        printw("%s", token);
-        attroff(COLOR_PAIR(pair) | A_BOLD);
+// Texto já formatado, sem passar por printf
+static void saida_escrever(const char *texto, int tamanho) {
+    if (renderizador_ansi) {
+        ansi_escrever_n(texto, (size_t)tamanho);
     } else {
-        printw("%s", token);
+        addnstr(texto, tamanho);
     }
 }
 
-// Imprime sequência de fios com cores (formato: "/R/G/B/")
-static void imprimir_sequencia_fios_colorida(const char* sequencia, int cores_disponiveis) {
-    char buffer[64];
-    strncpy(buffer, sequencia, sizeof(buffer));
-    buffer[sizeof(buffer) - 1] = '\0';
+static void saida_printf(const char *formato, ...) {
+    va_list args;
+    va_start(args, formato);
+    saida_vprintf(formato, args);
+    va_end(args);
+}
 
-    char* token = strtok(buffer, "/");
-    while (token != NULL) {
-        printw("/");
-        if (*token != '\0') {
-            imprimir_fio_token(token, cores_disponiveis);
-        }
-        token = strtok(NULL, "/");
+static void saida_mvprintf(int linha, int coluna, const char *formato, ...) {
+    saida_mover(linha, coluna);
+    va_list args;
+    va_start(args, formato);
+    saida_vprintf(formato, args);
+    va_end(args);
+}
+
+// Par 0 = cor padrão; substitui o atributo anterior (attrset, não attron)
+static void saida_atributo(int negrito, int par) {
+    if (renderizador_ansi) {
+        ansi_atributo((negrito ? ANSI_NEGRITO : 0) | par);
+    } else {
+        attrset((negrito ? A_BOLD : A_NORMAL) | COLOR_PAIR(par));
+    }
+}
+
+// Bytes e write() por quadro da partida (ncurses: medidos em /proc/self/io com TEDAX_MEDIR)
+static int qtd_quadros = 0;
+static long long soma_bytes_quadros = 0;
+static long long max_bytes_quadro = 0;
+static long long soma_writes_quadros = 0;
+static int fd_proc_io = -1;
+
+static void ler_proc_io(long long *bytes, long long *writes) {
+    char texto[512];
+    *bytes = *writes = 0;
+    if (fd_proc_io < 0) {
+        fd_proc_io = open("/proc/self/io", O_RDONLY);
+    }
+    ssize_t n = fd_proc_io >= 0 ? pread(fd_proc_io, texto, sizeof(texto) - 1, 0) : -1;
+    if (n <= 0) {
+        return;
+    }
+    texto[n] = '\0';
+    const char *p = strstr(texto, "wchar:");
+    if (p) *bytes = atoll(p + 6);
+    p = strstr(texto, "syscw:");
+    if (p) *writes = atoll(p + 6);
+}
+
+static void registrar_quadro(long long bytes, long long writes) {
+    if (bytes == 0 && writes == 0) {
+        return;
+    }
+    qtd_quadros++;
+    soma_bytes_quadros += bytes;
+    soma_writes_quadros += writes;
+    if (bytes > max_bytes_quadro) {
+        max_bytes_quadro = bytes;
     }
-    printw("/");
 }
 
-// Inicializa ncurses com configurações básicas
+static void saida_apresentar(void) {
+    if (renderizador_ansi) {
+        int writes;
+        size_t bytes = ansi_apresentar(STDOUT_FILENO, &writes);
+        registrar_quadro((long long)bytes, writes);
+    } else if (medir_quadros) {
+        long long bytes_antes, writes_antes, bytes_depois, writes_depois;
+        ler_proc_io(&bytes_antes, &writes_antes);
+        refresh();
+        ler_proc_io(&bytes_depois, &writes_depois);
+        registrar_quadro(bytes_depois - bytes_antes, writes_depois - writes_antes);
+    } else {
+        refresh();
+    }
+}
+
+void estatisticas_quadros(const char **renderizador, int *qtd, double *media_bytes,
+                          long long *max_bytes, double *writes_por_quadro) {
+    *renderizador = usar_ansi() ? "ansi" : "ncurses";
+    *qtd = qtd_quadros;
+    *media_bytes = qtd_quadros ? (double)soma_bytes_quadros / qtd_quadros : 0;
+    *max_bytes = max_bytes_quadro;
+    *writes_por_quadro = qtd_quadros ? (double)soma_writes_quadros / qtd_quadros : 0;
+}
+
+// Linha de cada módulo do mural, já formatada em trechos de mesmo atributo. Só é refeita
+// quando o módulo muda (estado, tempo de execução) ou numa partida nova; trechos vizinhos
+// com o mesmo atributo viram um só, escrito numa chamada.
+#define TAMANHO_LINHA_MODULO 192
+#define MAX_TRECHOS_LINHA 40
+
+typedef struct {
+    short inicio;
+    short tamanho;
+    unsigned char negrito;
+    unsigned char par;
+} TrechoLinha;
+
+typedef struct {
+    int valida;
+    int id;
+    int tempo_total;
+    unsigned char estado;
+    unsigned char cores;
+    int qtd_trechos;
+    TrechoLinha trechos[MAX_TRECHOS_LINHA];
+    char texto[TAMANHO_LINHA_MODULO];
+} LinhaModulo;
+
+static LinhaModulo linhas_modulos[MAX_MODULOS];
+
+// Lista virtual do mural: índices dos módulos exibidos, em ordem. É refeita só quando o
+// mural muda (versao_mural), numa partida nova ou quando um resolvido passa do tempo de
+// exibição; fora isso cada quadro só lê a janela de linhas que cabe na tela.
+typedef struct {
+    int valido;
+    const GameState *partida;
+    unsigned int versao;
+    int tick_revisao;           // Tick da roda em que um resolvido sai da lista (INT_MAX = nenhum)
+    int indices[MAX_MODULOS];
+    int qtd;
+    int removidos;              // Resolvidos fora da lista
+    int resolvidos;             // Resolvidos na partida (cabeçalho)
+} MuralVirtual;
+
+static MuralVirtual mural_virtual;
+static int rolagem_mural = 0;           // Primeira linha da lista na janela
+static int capacidade_mural = 1;        // Linhas da janela no último quadro
+
+// O renderizador ANSI escreve por fora do ncurses: a tela começa limpa para os dois
+// lados e, ao sair, o ncurses redesenha tudo no próximo refresh
+void iniciar_tela_partida(void) {
+    mural_virtual.valido = 0;
+    rolagem_mural = 0;
+    for (int i = 0; i < MAX_MODULOS; i++) {
+        linhas_modulos[i].valida = 0;
+    }
+    erase();
+    if (usar_ansi()) {
+        refresh();
+        ansi_invalidar();
+    }
+}
+
+void encerrar_tela_partida(void) {
+    if (renderizador_ansi) {
+        clearok(curscr, TRUE);
+    }
+}
+
+// Sessão ncurses única do processo: aberta uma vez (com as cores) e fechada só na saída
+static int ncurses_ativo = 0;
+
 void inicializar_ncurses(void) {
+    if (ncurses_ativo) {
+        return;
+    }
     initscr();
     cbreak();
     noecho();
     keypad(stdscr, TRUE);
     curs_set(0);
-    nodelay(stdscr, TRUE);
-    timeout(0);
+    if (has_colors()) {
+        start_color();
+        init_pair(1, COLOR_CYAN, COLOR_BLACK);
+        init_pair(2, COLOR_GREEN, COLOR_BLACK);
+        init_pair(3, COLOR_YELLOW, COLOR_BLACK);
+        init_pair(4, COLOR_RED, COLOR_BLACK);
+        init_pair(5, COLOR_BLUE, COLOR_BLACK);
+        init_pair(6, COLOR_WHITE, COLOR_BLACK);
+        init_pair(7, COLOR_BLACK, COLOR_WHITE);
+    }
+    definir_entrada_bloqueante(1);
+    ncurses_ativo = 1;
 }
 
 void finalizar_ncurses(void) {
+    if (!ncurses_ativo) {
+        return;
+    }
     keypad(stdscr, FALSE);
     echo();
     curs_set(1);
     endwin();
+    ansi_finalizar();
+    ncurses_ativo = 0;
+}
+
+// Menus esperam tecla; durante a partida o coordenador consulta sem bloquear
+void definir_entrada_bloqueante(int bloqueante) {
+    nodelay(stdscr, bloqueante ? FALSE : TRUE);
+    timeout(bloqueante ? -1 : 0);
+}
+
+// Tempo de troca de tela: da decisão (tecla aceita) até o primeiro refresh da tela nova
+static struct timespec inicio_transicao;
+static int transicao_pendente = 0;
+static int qtd_transicoes = 0;
+static double soma_transicoes_ms = 0;
+static double max_transicao_ms = 0;
+
+void iniciar_transicao_tela(Tela destino) {
+    if (destino == TELA_SAIR) {
+        transicao_pendente = 0;
+        return;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &inicio_transicao);
+    transicao_pendente = 1;
+}
+
+static void concluir_transicao_tela(void) {
+    if (!transicao_pendente) {
+        return;
+    }
+    struct timespec agora;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    double ms = ms_entre(&inicio_transicao, &agora);
+    transicao_pendente = 0;
+    qtd_transicoes++;
+    soma_transicoes_ms += ms;
+    if (ms > max_transicao_ms) {
+        max_transicao_ms = ms;
+    }
+}
+
+void estatisticas_transicao_tela(int *qtd, double *media_ms, double *max_ms) {
+    *qtd = qtd_transicoes;
+    *media_ms = qtd_transicoes ? soma_transicoes_ms / qtd_transicoes : 0;
+    *max_ms = max_transicao_ms;
+}
+
+// Fim da partida até o menu pós-jogo: inclui acordar e juntar as threads da partida
+static struct timespec inicio_fim_partida;
+static int fim_partida_pendente = 0;
+static int qtd_fins_partida = 0;
+static double soma_fins_partida_ms = 0;
+static double max_fim_partida_ms = 0;
+
+void iniciar_fim_partida(const struct timespec *instante_encerramento) {
+    inicio_fim_partida = *instante_encerramento;
+    fim_partida_pendente = 1;
+}
+
+static void concluir_fim_partida(void) {
+    if (!fim_partida_pendente) {
+        return;
+    }
+    struct timespec agora;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    double ms = ms_entre(&inicio_fim_partida, &agora);
+    fim_partida_pendente = 0;
+    qtd_fins_partida++;
+    soma_fins_partida_ms += ms;
+    if (ms > max_fim_partida_ms) {
+        max_fim_partida_ms = ms;
+    }
+}
+
+void estatisticas_fim_partida(int *qtd, double *media_ms, double *max_ms) {
+    *qtd = qtd_fins_partida;
+    *media_ms = qtd_fins_partida ? soma_fins_partida_ms / qtd_fins_partida : 0;
+    *max_ms = max_fim_partida_ms;
 }
 
 // Gera barra de progresso visual (ex: "######---- 50%")
@@ -107,245 +356,408 @@ void gerar_barra_progresso(char *buffer, int tamanho_buffer, int tempo_total, in
     snprintf(buffer + pos, tamanho_buffer - pos, " %d%%", progresso);
 }
 
+static const MuralVirtual* atualizar_mural_virtual(const GameState *g) {
+    MuralVirtual *mv = &mural_virtual;
+    if (mv->partida != g) {
+        // Outra bomba (Extras): as linhas em cache e a rolagem eram da anterior
+        mv->partida = g;
+        mv->valido = 0;
+        rolagem_mural = 0;
+        for (int i = 0; i < MAX_MODULOS; i++) {
+            linhas_modulos[i].valida = 0;
+        }
+    }
+    if (mv->valido && mv->versao == g->versao_mural && g->roda.agora < mv->tick_revisao) {
+        return mv;
+    }
+    
+    // Com 8 ou mais resolvidos no prazo de exibição, eles somem em 10s em vez de 20s
+    const ModulosQuentes *q = &g->quente;
+    int resolvidos_no_prazo = 0;
+    for (int i = 0; i < g->qtd_modulos; i++) {
+        if (q->estado[i] == MOD_RESOLVIDO && segundos_desde_resolvido(g, i) >= 0) {
+            resolvidos_no_prazo++;
+        }
+    }
+    int tempo_limite_remocao = (resolvidos_no_prazo >= 8) ? 10 : 20;
+    int ticks_ocultos = (SEGUNDOS_RESOLVIDO_VISIVEL - tempo_limite_remocao) * TICKS_POR_SEGUNDO;
+    
+    mv->qtd = 0;
+    mv->removidos = 0;
+    mv->resolvidos = 0;
+    mv->tick_revisao = INT_MAX;
+    for (int i = 0; i < g->qtd_modulos; i++) {
+        if (q->estado[i] == MOD_RESOLVIDO) {
+            mv->resolvidos++;
+            int desde = segundos_desde_resolvido(g, i);
+            if (desde < 0 || desde >= tempo_limite_remocao) {
+                mv->removidos++;
+                continue;
+            }
+            // Sai da lista quando faltarem ticks_ocultos para o temporizador vencer
+            int sai_em = g->roda.agora +
+                         temporizador_restante(&g->roda, TEMPORIZADOR_RESOLVIDO(i)) - ticks_ocultos;
+            if (sai_em < mv->tick_revisao) {
+                mv->tick_revisao = sai_em;
+            }
+        }
+        mv->indices[mv->qtd++] = i;
+    }
+    mv->versao = g->versao_mural;
+    mv->valido = 1;
+    return mv;
+}
+
+void rolar_mural(int linhas, int paginas) {
+    rolagem_mural += linhas + paginas * capacidade_mural;
+    if (rolagem_mural < 0) {
+        rolagem_mural = 0;
+    }
+    // O limite de baixo depende da altura da janela: desenhar_tela ajusta
+}
+
+void redimensionar_tela_partida(void) {
+    if (renderizador_ansi) {
+        ansi_invalidar();
+    }
+}
+
+static void acrescentar_trecho(LinhaModulo *l, int negrito, int par, const char *formato, ...) {
+    int usado = l->qtd_trechos > 0 ? l->trechos[l->qtd_trechos - 1].inicio +
+                                     l->trechos[l->qtd_trechos - 1].tamanho : 0;
+    va_list args;
+    va_start(args, formato);
+    int n = vsnprintf(l->texto + usado, sizeof(l->texto) - (size_t)usado, formato, args);
+    va_end(args);
+    if (n <= 0) {
+        return;
+    }
+    if (usado + n >= (int)sizeof(l->texto)) {
+        n = (int)sizeof(l->texto) - 1 - usado;
+    }
+    
+    TrechoLinha *ultimo = l->qtd_trechos > 0 ? &l->trechos[l->qtd_trechos - 1] : NULL;
+    if (ultimo && ((ultimo->negrito == negrito && ultimo->par == par) ||
+                   l->qtd_trechos == MAX_TRECHOS_LINHA)) {
+        ultimo->tamanho = (short)(ultimo->tamanho + n);
+        return;
+    }
+    TrechoLinha *t = &l->trechos[l->qtd_trechos++];
+    t->inicio = (short)usado;
+    t->tamanho = (short)n;
+    t->negrito = (unsigned char)negrito;
+    t->par = (unsigned char)par;
+}
+
+static int par_fio(const char *token, size_t tamanho) {
+    if (tamanho != 1) {
+        return 0;
+    }
+    switch (token[0]) {
+        case 'R': return 4;
+        case 'G': return 2;
+        case 'B': return 5;
+        case 'Y': return 3;
+        case 'W': return 6;
+        case 'K': return 7;
+        default:  return 0;
+    }
+}
+
+// Sequência de fios com cores (formato: "/R/G/B/"); barras repetidas contam como uma
+static void acrescentar_sequencia_fios(LinhaModulo *l, const char *sequencia) {
+    const char *p = sequencia;
+    while (*p) {
+        while (*p == '/') {
+            p++;
+        }
+        size_t tamanho = strcspn(p, "/");
+        if (tamanho == 0) {
+            break;
+        }
+        acrescentar_trecho(l, 0, 0, "/");
+        int par = par_fio(p, tamanho);
+        acrescentar_trecho(l, par > 0, par, "%.*s", (int)tamanho, p);
+        p += tamanho;
+    }
+    acrescentar_trecho(l, 0, 0, "/");
+}
+
+static void formatar_linha_modulo(LinhaModulo *l, const Modulo *mod, int id, int estado, int cores) {
+    const char* estado_str = nome_estado_modulo((EstadoModulo)estado);
+    l->qtd_trechos = 0;
+    l->texto[0] = '\0';
+    
+    if (mod->tipo == TIPO_BOTAO && cores) {
+        CorBotao cor = mod->dados.botao.cor;
+        int par = (cor == COR_VERMELHO) ? 4 : (cor == COR_VERDE) ? 2 : 5;
+        acrescentar_trecho(l, 0, 0, "  M%d Botao ", id);
+        acrescentar_trecho(l, 1, par, "%s", nome_cor(cor));
+        acrescentar_trecho(l, 0, 0, " - %s", estado_str);
+    } else if (mod->tipo == TIPO_FIOS && cores) {
+        acrescentar_trecho(l, 0, 0, "  M%d Fios ", id);
+        acrescentar_sequencia_fios(l, mod->dados.fios.sequencia);
+        acrescentar_trecho(l, 0, 0, " (Padrao %d) - %s", mod->dados.fios.padrao, estado_str);
+    } else {
+        // Sem cores ou outros tipos de módulo
+        char info_modulo[128];
+        obter_info_exibicao_modulo(mod, info_modulo, sizeof(info_modulo));
+        acrescentar_trecho(l, 0, 0, "  M%d %s - %s", id, info_modulo, estado_str);
+    }
+    if (estado == MOD_PENDENTE) {
+        acrescentar_trecho(l, 0, 0, " - Execucao: %d sec", mod->tempo_total);
+    }
+}
+
+static void desenhar_linha_modulo(const GameState *g, int i, int linha, int cores) {
+    const Modulo *mod = &g->modulos[i];
+    LinhaModulo *l = &linhas_modulos[i];
+    int estado = g->quente.estado[i];
+    int id = g->quente.id[i];
+    
+    if (!l->valida || l->id != id || l->estado != estado || l->tempo_total != mod->tempo_total ||
+        l->cores != cores) {
+        formatar_linha_modulo(l, mod, id, estado, cores);
+        l->id = id;
+        l->estado = (unsigned char)estado;
+        l->tempo_total = mod->tempo_total;
+        l->cores = (unsigned char)cores;
+        l->valida = 1;
+    }
+    
+    saida_mover(linha, 0);
+    for (int k = 0; k < l->qtd_trechos; k++) {
+        const TrechoLinha *t = &l->trechos[k];
+        if (t->negrito || t->par) {
+            saida_atributo(t->negrito, t->par);
+            saida_escrever(l->texto + t->inicio, t->tamanho);
+            saida_atributo(0, 0);
+        } else {
+            saida_escrever(l->texto + t->inicio, t->tamanho);
+        }
+    }
+}
+
 // Desenha toda a interface do jogo na tela
 void desenhar_tela(const GameState *g, const char *buffer_instrucao) {
-    clear();
+    desenhar_tela_bombas(g, buffer_instrucao, NULL, 0, 0);
+}
+
+void desenhar_tela_bombas(const GameState *g, const char *buffer_instrucao,
+                          const ResumoBomba *bombas, int qtd_bombas, int atual) {
+    saida_limpar();
     
     int linha = 0;
     int cores_disponiveis = has_colors();
     
-    attron(A_BOLD);
-    mvprintw(linha++, 0, "=== KEEP SOLVING AND NOBODY EXPLODES ===");
-    attroff(A_BOLD);
+    saida_atributo(1, 0);
+    saida_mvprintf(linha++, 0, "=== KEEP SOLVING AND NOBODY EXPLODES ===");
+    saida_atributo(0, 0);
     linha++;
     
-    if (cores_disponiveis) {
-        attron(A_BOLD | COLOR_PAIR(1));
-    } else {
-        attron(A_BOLD);
+    // Extras: uma linha por bomba; a selecionada é detalhada abaixo
+    if (qtd_bombas > 0) {
+        saida_mvprintf(linha++, 0, "--- BOMBAS (%d; TAB troca) ---", qtd_bombas);
+        for (int i = 0; i < qtd_bombas; i++) {
+            const ResumoBomba *b = &bombas[i];
+            int par = b->estado == BOMBA_DESARMADA ? 2 : b->estado == BOMBA_EXPLODIU ? 4 : 0;
+            saida_atributo(i == atual, cores_disponiveis ? par : 0);
+            saida_mvprintf(linha++, 0, "%c Bomba %d: %3ds  %d/%d resolvidos  %d erro(s)  %s",
+                           i == atual ? '>' : ' ', i + 1, b->tempo_restante, b->resolvidos,
+                           b->necessarios, b->erros,
+                           b->estado == BOMBA_DESARMADA ? "DESARMADA" :
+                           b->estado == BOMBA_EXPLODIU ? "EXPLODIU" : "ATIVA");
+            saida_atributo(0, 0);
+        }
+        linha++;
     }
-    mvprintw(linha++, 0, "Dificuldade: %s | Tempo Restante: %d segundos | Modulos: %d/%d resolvidos", 
+    
+    saida_atributo(1, cores_disponiveis ? 1 : 0);
+    saida_mvprintf(linha++, 0, "Dificuldade: %s | Tempo Restante: %d segundos | Modulos: %d/%d resolvidos", 
              nome_dificuldade(g->dificuldade), g->tempo_restante, 
-             contar_modulos_resolvidos(g), g->modulos_necessarios);
-    if (cores_disponiveis) {
-        attroff(A_BOLD | COLOR_PAIR(1));
-    } else {
-        attroff(A_BOLD);
-    }
+             atualizar_mural_virtual(g)->resolvidos, g->modulos_necessarios);
+    saida_atributo(0, 0);
     linha++;
     
-    mvprintw(linha++, 0, "--- TEDAX (%d total) ---", g->qtd_tedax);
+    saida_mvprintf(linha++, 0, "--- TEDAX (%d total) ---", g->qtd_tedax);
     for (int i = 0; i < g->qtd_tedax; i++) {
         const Tedax *t = &g->tedax[i];
         if (t->estado == TEDAX_LIVRE) {
             if (cores_disponiveis) {
-                attron(COLOR_PAIR(2));
+                saida_atributo(0, 2);
             }
-            mvprintw(linha++, 0, "  Tedax %d: LIVRE", t->id);
+            saida_mvprintf(linha++, 0, "  Tedax %d: LIVRE", t->id);
             if (cores_disponiveis) {
-                attroff(COLOR_PAIR(2));
+                saida_atributo(0, 0);
             }
         } else if (t->estado == TEDAX_ESPERANDO) {
             if (cores_disponiveis) {
-                attron(COLOR_PAIR(3));
+                saida_atributo(0, 3);
+            }
+            char alvo[32];
+            if (t->bancada_atual >= 0) {
+                snprintf(alvo, sizeof(alvo), "Bancada %d", g->bancadas[t->bancada_atual].id);
+            } else {
+                snprintf(alvo, sizeof(alvo), "qualquer bancada");
             }
             if (t->modulo_atual >= 0) {
-                const Modulo *mod = &g->modulos[t->modulo_atual];
-                mvprintw(linha++, 0, "  Tedax %d: ESPERANDO (Bancada %d) - Aguardando para M%d", 
-                         t->id, t->bancada_atual >= 0 ? g->bancadas[t->bancada_atual].id : 0,
-                         mod->id);
+                saida_mvprintf(linha++, 0, "  Tedax %d: ESPERANDO (%s) - Aguardando para M%d", 
+                         t->id, alvo, g->quente.id[t->modulo_atual]);
             } else {
-                mvprintw(linha++, 0, "  Tedax %d: ESPERANDO (Bancada %d)", t->id, 
-                         t->bancada_atual >= 0 ? g->bancadas[t->bancada_atual].id : 0);
+                saida_mvprintf(linha++, 0, "  Tedax %d: ESPERANDO (%s)", t->id, alvo);
             }
             if (cores_disponiveis) {
-                attroff(COLOR_PAIR(3));
+                saida_atributo(0, 0);
             }
         } else {
             if (cores_disponiveis) {
-                attron(COLOR_PAIR(3));
+                saida_atributo(0, 3);
             }
             if (t->modulo_atual >= 0) {
-                const Modulo *mod = &g->modulos[t->modulo_atual];
+                int m = t->modulo_atual;
                 char barra[32];
-                gerar_barra_progresso(barra, sizeof(barra), mod->tempo_total, mod->tempo_restante);
-                mvprintw(linha++, 0, "  Tedax %d: OCUPADO - Desarmando M%d - %s",
-                         t->id, mod->id, barra);
-                if (t->qtd_fila > 0 && t->fila_modulos[0] >= 0 && t->fila_modulos[0] < g->qtd_modulos) {
-                    const Modulo *mod_fila = &g->modulos[t->fila_modulos[0]];
-                    mvprintw(linha++, 0, "    Fila: M%d",
-                             mod_fila->id);
+                gerar_barra_progresso(barra, sizeof(barra), g->modulos[m].tempo_total, tempo_restante_modulo(g, m));
+                saida_mvprintf(linha++, 0, "  Tedax %d: OCUPADO - Desarmando M%d - %s",
+                         t->id, g->quente.id[m], barra);
+                if (t->qtd_fila > 0) {
+                    saida_mover(linha++, 0);
+                    saida_printf("    Fila (%d/%d):", t->qtd_fila, t->capacidade_fila);
+                    for (int k = 0; k < t->qtd_fila; k++) {
+                        int idx_fila = t->fila[(t->inicio_fila + k) % MAX_FILA_TEDAX].modulo_idx;
+                        if (idx_fila >= 0 && idx_fila < g->qtd_modulos) {
+                            saida_printf(" M%d", g->quente.id[idx_fila]);
+                        }
+                    }
                 }
             } else {
-                mvprintw(linha++, 0, "  Tedax %d: OCUPADO", t->id);
+                saida_mvprintf(linha++, 0, "  Tedax %d: OCUPADO", t->id);
             }
             if (cores_disponiveis) {
-                attroff(COLOR_PAIR(3));
+                saida_atributo(0, 0);
             }
         }
     }
     linha++;
     
-    mvprintw(linha++, 0, "--- BANCADAS (%d total) ---", g->qtd_bancadas);
+    saida_mvprintf(linha++, 0, "--- BANCADAS (%d total) ---", g->qtd_bancadas);
     for (int i = 0; i < g->qtd_bancadas; i++) {
         const Bancada *b = &g->bancadas[i];
         if (b->estado == BANCADA_LIVRE) {
             if (cores_disponiveis) {
-                attron(COLOR_PAIR(2));
+                saida_atributo(0, 2);
             }
-            mvprintw(linha++, 0, "  Bancada %d: LIVRE", b->id);
+            saida_mvprintf(linha++, 0, "  Bancada %d: LIVRE", b->id);
             if (cores_disponiveis) {
-                attroff(COLOR_PAIR(2));
+                saida_atributo(0, 0);
             }
         } else {
             if (cores_disponiveis) {
-                attron(COLOR_PAIR(3));
+                saida_atributo(0, 3);
             }
-            mvprintw(linha++, 0, "  Bancada %d: OCUPADA (Tedax %d)", b->id, b->tedax_ocupando);
-            if (b->tedax_esperando >= 0) {
-                mvprintw(linha++, 0, "    Esperando: Tedax %d", b->tedax_esperando);
+            saida_mvprintf(linha++, 0, "  Bancada %d: OCUPADA (Tedax %d)", b->id, b->tedax_ocupando);
+            if (b->espera.qtd > 0) {
+                saida_mover(linha++, 0);
+                saida_printf("    Esperando:");
+                for (int k = 0; k < b->espera.qtd; k++) {
+                    saida_printf(" Tedax %d", b->espera.tedax_ids[(b->espera.inicio + k) % MAX_TEDAX]);
+                }
             }
             if (cores_disponiveis) {
-                attroff(COLOR_PAIR(3));
+                saida_atributo(0, 0);
             }
         }
     }
-    linha++;
-    
-    mvprintw(linha++, 0, "--- MODULOS (%d total) ---", g->qtd_modulos);
-    
-    // Calcula tempo limite para remoção de módulos resolvidos (10s se >=8 visíveis, 20s caso contrário)
-    int resolvidos_visiveis_20s = 0;
-    for (int i = 0; i < g->qtd_modulos; i++) {
-        const Modulo *mod = &g->modulos[i];
-        if (mod->estado == MOD_RESOLVIDO && mod->tempo_desde_resolvido >= 0 && mod->tempo_desde_resolvido < 20) {
-            resolvidos_visiveis_20s++;
+    if (g->espera_global.qtd > 0) {
+        saida_mover(linha++, 0);
+        saida_printf("  Fila geral:");
+        for (int k = 0; k < g->espera_global.qtd; k++) {
+            saida_printf(" Tedax %d", g->espera_global.tedax_ids[(g->espera_global.inicio + k) % MAX_TEDAX]);
         }
     }
+    linha++;
     
-    int tempo_limite_remocao = (resolvidos_visiveis_20s >= 8) ? 10 : 20;
+    // Só as linhas da janela visível do mural são percorridas e desenhadas
+    const MuralVirtual *mv = atualizar_mural_virtual(g);
+    int capacidade = LINES - 8 - (linha + 1);
+    if (capacidade < 1) {
+        capacidade = 1;
+    }
+    int max_rolagem = mv->qtd > capacidade ? mv->qtd - capacidade : 0;
+    if (rolagem_mural > max_rolagem) {
+        rolagem_mural = max_rolagem;
+    }
+    capacidade_mural = capacidade;
+    int fim_janela = rolagem_mural + capacidade < mv->qtd ? rolagem_mural + capacidade : mv->qtd;
     
-    int pendentes = 0, em_execucao = 0, resolvidos = 0;
-    int modulos_exibidos = 0;
-    int modulos_nao_exibidos = 0;
+    if (mv->qtd > capacidade) {
+        saida_mvprintf(linha++, 0, "--- MODULOS (%d total) --- [%d-%d de %d; setas/PgUp/PgDn rolam]",
+                       g->qtd_modulos, rolagem_mural + 1, fim_janela, mv->qtd);
+    } else {
+        saida_mvprintf(linha++, 0, "--- MODULOS (%d total) ---", g->qtd_modulos);
+    }
     
-    for (int i = 0; i < g->qtd_modulos; i++) {
-        const Modulo *mod = &g->modulos[i];
-        
-        // Filtra módulos resolvidos antigos para manter tela limpa
-        int deve_exibir = 1;
-        if (mod->estado == MOD_RESOLVIDO) {
-            if (mod->tempo_desde_resolvido < 0 || mod->tempo_desde_resolvido >= tempo_limite_remocao) {
-                deve_exibir = 0;
-                modulos_nao_exibidos++;
-            }
-        }
-        
-        if (!deve_exibir) {
-            continue;
-        }
-        
-        switch (mod->estado) {
-            case MOD_PENDENTE:
-                pendentes++;
-                break;
-            case MOD_EM_EXECUCAO:
-                em_execucao++;
-                break;
-            case MOD_RESOLVIDO:
-                resolvidos++;
-                break;
-        }
-        
-        // Exibe módulo com cores quando disponíveis
-        const char* estado_str = nome_estado_modulo(mod->estado);
-        int cores_disponiveis = has_colors();
-
-        if (mod->tipo == TIPO_BOTAO && cores_disponiveis) {
-            move(linha, 0);
-            printw("  M%d Botao ", mod->id);
-            imprimir_cor_botao(mod->dados.botao.cor, cores_disponiveis);
-            printw(" - %s", estado_str);
-            if (mod->estado == MOD_PENDENTE) {
-                printw(" - Execucao: %d sec", mod->tempo_total);
-            }
-        } else if (mod->tipo == TIPO_FIOS && cores_disponiveis) {
-            move(linha, 0);
-            printw("  M%d Fios ", mod->id);
-            imprimir_sequencia_fios_colorida(mod->dados.fios.sequencia, cores_disponiveis);
-            printw(" (Padrao %d) - %s", mod->dados.fios.padrao, estado_str);
-            if (mod->estado == MOD_PENDENTE) {
-                printw(" - Execucao: %d sec", mod->tempo_total);
-            }
-        } else {
-            // Fallback: sem cores ou outros tipos de módulo
-            char info_modulo[128];
-            obter_info_exibicao_modulo(mod, info_modulo, sizeof(info_modulo));
-            
-            move(linha, 0);
-            if (mod->estado == MOD_PENDENTE) {
-                printw("  M%d %s - %s - Execucao: %d sec", 
-                       mod->id, info_modulo, estado_str, mod->tempo_total);
-            } else {
-                printw("  M%d %s - %s", 
-                       mod->id, info_modulo, estado_str);
-            }
-        }
-        
-        linha++;
-        modulos_exibidos++;
-        
-        // Limita exibição para não ultrapassar a tela
-        if (linha >= LINES - 8) {
-            int restantes = 0;
-            for (int j = i + 1; j < g->qtd_modulos; j++) {
-                const Modulo *mod_rest = &g->modulos[j];
-                if (mod_rest->estado != MOD_RESOLVIDO || 
-                    (mod_rest->tempo_desde_resolvido >= 0 && mod_rest->tempo_desde_resolvido < tempo_limite_remocao)) {
-                    restantes++;
-                }
-            }
-            if (restantes > 0) {
-                mvprintw(linha++, 0, "  ... (mais %d modulos)", restantes);
-            }
-            break;
-        }
+    for (int k = rolagem_mural; k < fim_janela; k++) {
+        desenhar_linha_modulo(g, mv->indices[k], linha++, cores_disponiveis);
+    }
+    if (fim_janela < mv->qtd) {
+        saida_mvprintf(linha++, 0, "  ... (mais %d modulos)", mv->qtd - fim_janela);
     }
     
-    if (modulos_nao_exibidos > 0) {
+    if (mv->removidos > 0) {
         linha++;
-        mvprintw(linha++, 0, "  (%d resolvidos removidos)", modulos_nao_exibidos);
+        saida_mvprintf(linha++, 0, "  (%d resolvidos removidos)", mv->removidos);
     }
     
     linha++;
     
-    mvprintw(linha++, 0, "Comando: [%s]", buffer_instrucao);
+    saida_mvprintf(linha++, 0, "Comando: [%s]", buffer_instrucao);
     linha++;
     
     // Exibe mensagem de erro se houver
     if (g->mensagem_erro[0] != '\0') {
-        if (cores_disponiveis) {
-            attron(A_BOLD | COLOR_PAIR(3));
-        } else {
-            attron(A_BOLD);
-        }
-        mvprintw(linha++, 0, "%s", g->mensagem_erro);
-        if (cores_disponiveis) {
-            attroff(A_BOLD | COLOR_PAIR(3));
-        } else {
-            attroff(A_BOLD);
-        }
+        saida_atributo(1, cores_disponiveis ? 3 : 0);
+        saida_mvprintf(linha++, 0, "%s", g->mensagem_erro);
+        saida_atributo(0, 0);
         linha++;
     }
     
-    refresh();
+    saida_apresentar();
+    concluir_transicao_tela();
+}
+
+// Uso de tedax e bancadas na partida, no alto da tela (acima do resultado)
+static void desenhar_utilizacao(const ResumoUtilizacao *uso) {
+    int linha = 1;
+    attron(A_BOLD);
+    mvprintw(linha++, 2, "Utilizacao (%% do tempo da partida)");
+    attroff(A_BOLD);
+    for (int i = 0; i < uso->qtd_tedax; i++) {
+        mvprintw(linha++, 2, "Tedax %d: ocupado %3.0f%%  esperando bancada %3.0f%%  livre %3.0f%%", i + 1,
+                 uso->tedax[i][TEDAX_OCUPADO], uso->tedax[i][TEDAX_ESPERANDO], uso->tedax[i][TEDAX_LIVRE]);
+    }
+    mvprintw(linha, 2, "Bancadas ocupadas:");
+    for (int i = 0; i < uso->qtd_bancadas; i++) {
+        printw("  B%d %3.0f%%", i + 1, uso->bancada_ocupada[i]);
+    }
+    linha++;
+    mvprintw(linha++, 2, "Comando ate a bancada: media %.1fs, max %.1fs (%d)",
+             uso->espera_media, uso->espera_max, uso->esperas);
+    mvprintw(linha++, 2, "Mural ate resolvido: media %.1fs, max %ds (%d modulos)",
+             uso->latencia_media, uso->latencia_max, uso->resolvidos);
+    mvprintw(linha++, 2, "Gargalo: %s (tedax esperando bancada %.0f%%, modulo esperando tedax %.0f%%)",
+             uso->gargalo, uso->tedax_esperando, uso->pendente_sem_tedax);
 }
 
 // Menu pós-jogo: retorna 'q'/'Q' para sair, 'r'/'R' para voltar ao menu
-int mostrar_menu_pos_jogo(int vitoria, int tempo_restante, int erros) {
-    clear();
+int mostrar_menu_pos_jogo(int vitoria, int tempo_restante, int erros, const ResumoPlacar *placar,
+                          const ResumoUtilizacao *uso) {
+    erase();
     int cores_disponiveis = has_colors();
     
+    if (uso) {
+        desenhar_utilizacao(uso);
+    }
+    
     if (vitoria) {
         if (cores_disponiveis) {
             attron(A_BOLD | COLOR_PAIR(2));
@@ -385,15 +797,42 @@ int mostrar_menu_pos_jogo(int vitoria, int tempo_restante, int erros) {
     mvprintw(linha_opcoes, COLS / 2 - 15, "Pressione R para voltar ao Menu");
     mvprintw(linha_opcoes + 1, COLS / 2 - 15, "Pressione Q para Sair");
     
-    // Reconfigura entrada para modo bloqueante (threads usam nodelay/timeout(0))
+    // Placar persistente da dificuldade jogada (placar.log/placar.idx)
+    if (placar) {
+        int linha = linha_opcoes + 3;
+        attron(A_BOLD);
+        mvprintw(linha++, COLS / 2 - 15, "Melhores - %s", nome_dificuldade(placar->dificuldade));
+        attroff(A_BOLD);
+        if (placar->qtd_top == 0) {
+            mvprintw(linha++, COLS / 2 - 15, "  (nenhuma vitoria registrada)");
+        }
+        for (int i = 0; i < placar->qtd_top; i++) {
+            const EntradaPlacar *e = &placar->top[i];
+            int destaque = (placar->posicao_partida == i + 1);
+            if (destaque) {
+                attron(A_BOLD | (cores_disponiveis ? COLOR_PAIR(2) : 0));
+            }
+            mvprintw(linha++, COLS / 2 - 15, "%d. %-15s %4ds  %d erro(s)%s", i + 1, e->jogador,
+                     e->tempo_restante, e->erros, destaque ? "  <- esta partida" : "");
+            if (destaque) {
+                attroff(A_BOLD | (cores_disponiveis ? COLOR_PAIR(2) : 0));
+            }
+        }
+        if (placar->tem_recorde) {
+            mvprintw(linha + 1, COLS / 2 - 15, "Seu recorde (%s): %ds, %d erro(s)%s", nome_jogador_placar(),
+                     placar->recorde.tempo_restante, placar->recorde.erros,
+                     placar->novo_recorde ? "  NOVO RECORDE!" : "");
+        } else {
+            mvprintw(linha + 1, COLS / 2 - 15, "Seu recorde (%s): -", nome_jogador_placar());
+        }
+        mvprintw(linha + 2, COLS / 2 - 15, "Partidas registradas: %lld", placar->partidas_registradas);
+    }
+    
     refresh();
+    concluir_transicao_tela();
+    concluir_fim_partida();
     flushinp();
-    nodelay(stdscr, FALSE);
-    timeout(-1);
-    keypad(stdscr, TRUE);
-    cbreak();
-    noecho();
-    curs_set(0);
+    definir_entrada_bloqueante(1);
     int ch;
     while (1) {
         ch = getch();
@@ -406,27 +845,26 @@ int mostrar_menu_pos_jogo(int vitoria, int tempo_restante, int erros) {
 }
 
 void mostrar_mensagem_vitoria(void) {
-    mostrar_menu_pos_jogo(1, 0, 0);
+    mostrar_menu_pos_jogo(1, 0, 0, NULL, NULL);
 }
 
 void mostrar_mensagem_derrota(void) {
-    mostrar_menu_pos_jogo(0, 0, 0);
+    mostrar_menu_pos_jogo(0, 0, 0, NULL, NULL);
 }
 
 static int musica_ligada_global = 0;
 extern int audio_disponivel_global;
 
-// Menu principal: retorna 0=Classico, 1-6=Outros modos, -1=Sair
+// Menu principal: retorna 0=Classico, 3=Extras, 5=Custom, -1=Sair
 int mostrar_menu_principal(void) {
-    clear();
+    erase();
     int cores_disponiveis = has_colors();
     int selecao = 0;
     
-    nodelay(stdscr, FALSE);
-    timeout(-1);
+    definir_entrada_bloqueante(1);
     
     while (1) {
-        clear();
+        erase();
         
         attron(A_BOLD);
         mvprintw(LINES / 2 - 10, COLS / 2 - 20, "========================================");
@@ -442,9 +880,9 @@ int mostrar_menu_principal(void) {
             "1. Classico",
             "2. Especialistas [Em Breve]",
             "3. Sobrevivencia [Em Breve]",
-            "4. Extras [Em Breve]",
+            "4. Extras",
             "5. Treino [Em Breve]",
-            "6. Custom [Em Breve]",
+            "6. Custom",
             "C. Configs [Em Breve]",
             texto_musica,
             "Q. Sair"
@@ -479,7 +917,14 @@ int mostrar_menu_principal(void) {
             }
         }
         
+        // Erro da última recarga de fases.cfg (configuração anterior continua valendo)
+        char erro_fases[128];
+        if (erro_config_fases(erro_fases, sizeof(erro_fases))) {
+            mvprintw(LINES / 2 + 8, COLS / 2 - 20, "%s", erro_fases);
+        }
+        
         refresh();
+        concluir_transicao_tela();
         
         int ch = getch();
         if (ch == KEY_UP || ch == 'w' || ch == 'W') {
@@ -489,21 +934,20 @@ int mostrar_menu_principal(void) {
         } else if (ch == '\n' || ch == '\r' || ch == KEY_ENTER) {
             if (selecao == 0) {
                 return 0;
-            } else if (selecao >= 1 && selecao <= 5) {
+            } else if (selecao == 3 || selecao == 5) {
+                return selecao;
+            } else if (selecao == 1 || selecao == 2 || selecao == 4) {
             } else if (selecao == 6) {
             } else if (selecao == 7) {
                 // Toggle música
                 definir_dificuldade_musica(0);
                 if (!audio_disponivel_global) {
-                    clear();
+                    erase();
                     mvprintw(LINES / 2, COLS / 2 - 30, "Audio nao disponivel!");
                     mvprintw(LINES / 2 + 1, COLS / 2 - 35, "Instale: sudo apt-get install libsdl2-mixer-dev");
                     mvprintw(LINES / 2 + 3, COLS / 2 - 15, "Pressione qualquer tecla...");
                     refresh();
-                    nodelay(stdscr, FALSE);
                     getch();
-                    nodelay(stdscr, FALSE);
-                    timeout(-1);
                 } else if (musica_ligada_global) {
                     parar_musica();
                     musica_ligada_global = 0;
@@ -513,15 +957,12 @@ int mostrar_menu_principal(void) {
                     if (tocar_musica("sounds/Menu.mp3")) {
                         musica_ligada_global = 1;
                     } else {
-                        clear();
+                        erase();
                         mvprintw(LINES / 2, COLS / 2 - 25, "Erro ao tocar musica!");
                         mvprintw(LINES / 2 + 1, COLS / 2 - 20, "Verifique: sounds/Menu.mp3");
                         mvprintw(LINES / 2 + 3, COLS / 2 - 15, "Pressione qualquer tecla...");
                         refresh();
-                        nodelay(stdscr, FALSE);
                         getch();
-                        nodelay(stdscr, FALSE);
-                        timeout(-1);
                     }
                 }
             } else if (selecao == 8) {
@@ -531,17 +972,18 @@ int mostrar_menu_principal(void) {
             return -1;
         } else if (ch == '1') {
             return 0;
+        } else if (ch == '4') {
+            return 3;
+        } else if (ch == '6') {
+            return 5;
         } else if (ch == 'm' || ch == 'M') {
             if (!audio_disponivel_global) {
-                clear();
+                erase();
                 mvprintw(LINES / 2, COLS / 2 - 30, "Audio nao disponivel!");
                 mvprintw(LINES / 2 + 1, COLS / 2 - 35, "Instale: sudo apt-get install libsdl2-mixer-dev");
                 mvprintw(LINES / 2 + 3, COLS / 2 - 15, "Pressione qualquer tecla...");
                 refresh();
-                nodelay(stdscr, FALSE);
                 getch();
-                nodelay(stdscr, FALSE);
-                timeout(-1);
             } else if (musica_ligada_global) {
                 parar_musica();
                 musica_ligada_global = 0;
@@ -552,15 +994,12 @@ int mostrar_menu_principal(void) {
                 if (tocar_musica("sounds/Menu.mp3")) {
                     musica_ligada_global = 1;
                 } else {
-                    clear();
+                    erase();
                     mvprintw(LINES / 2, COLS / 2 - 25, "Erro ao tocar musica!");
                     mvprintw(LINES / 2 + 1, COLS / 2 - 20, "Verifique: sounds/Menu.mp3");
                     mvprintw(LINES / 2 + 3, COLS / 2 - 15, "Pressione qualquer tecla...");
                     refresh();
-                    nodelay(stdscr, FALSE);
                     getch();
-                    nodelay(stdscr, FALSE);
-                    timeout(-1);
                 }
             }
         }
@@ -569,15 +1008,14 @@ int mostrar_menu_principal(void) {
 
 // Menu de dificuldades: retorna índice (0=Fácil, 1=Médio, 2=Difícil) ou -1 para sair
 int mostrar_menu_dificuldades(void) {
-    clear();
+    erase();
     int cores_disponiveis = has_colors();
     int selecao = 0;
     
-    nodelay(stdscr, FALSE);
-    timeout(-1);
+    definir_entrada_bloqueante(1);
     
     while (1) {
-        clear();
+        erase();
         
         attron(A_BOLD);
         mvprintw(LINES / 2 - 8, COLS / 2 - 20, "========================================");
@@ -616,6 +1054,7 @@ int mostrar_menu_dificuldades(void) {
         mvprintw(LINES / 2 + 5, COLS / 2 - 15, "Use SETAS para navegar, ENTER para selecionar");
         
         refresh();
+        concluir_transicao_tela();
         
         int ch = getch();
         
@@ -2,15 +2,65 @@
 #define UI_H
 
 #include "../game/game.h"
+#include "../placar/placar.h"
+#include "../utilizacao/utilizacao.h"
+
+// Telas do jogo (máquina de estados em main); todas usam a mesma sessão ncurses
+typedef enum {
+    TELA_MENU,
+    TELA_DIFICULDADE,
+    TELA_PARTIDA,
+    TELA_EXTRAS,
+    TELA_POS_JOGO,
+    TELA_SAIR
+} Tela;
+
+typedef enum {
+    BOMBA_ATIVA,
+    BOMBA_DESARMADA,
+    BOMBA_EXPLODIU
+} EstadoBomba;
+
+// Linha de uma bomba no resumo do modo Extras
+typedef struct {
+    int tempo_restante;
+    int resolvidos;
+    int necessarios;
+    int erros;
+    EstadoBomba estado;
+} ResumoBomba;
 
 void desenhar_tela(const GameState *g, const char *buffer_instrucao);
+// Extras: resumo de todas as bombas no topo e a bomba `atual` (g) detalhada abaixo
+void desenhar_tela_bombas(const GameState *g, const char *buffer_instrucao,
+                          const ResumoBomba *bombas, int qtd_bombas, int atual);
 void inicializar_ncurses(void);
 void finalizar_ncurses(void);
+void definir_entrada_bloqueante(int bloqueante);
+
+// Medição das trocas de tela (da decisão ao primeiro refresh da tela nova)
+void iniciar_transicao_tela(Tela destino);
+void estatisticas_transicao_tela(int *qtd, double *media_ms, double *max_ms);
+// Medição do fim da partida (encerrar_partida) até o primeiro refresh do menu pós-jogo
+void iniciar_fim_partida(const struct timespec *instante_encerramento);
+void estatisticas_fim_partida(int *qtd, double *media_ms, double *max_ms);
+
+// Tela da partida: TEDAX_RENDERIZADOR=ansi troca o ncurses pelo renderizador de src/ansi.
+// iniciar/encerrar envolvem a partida; as estatísticas dão bytes e write() por quadro
+void iniciar_tela_partida(void);
+void encerrar_tela_partida(void);
+void estatisticas_quadros(const char **renderizador, int *qtd, double *media_bytes,
+                          long long *max_bytes, double *writes_por_quadro);
+// Mural da partida (coordenador, com mutex_jogo): rolagem em linhas e/ou páginas da
+// janela visível; a tela mudou de tamanho (KEY_RESIZE, que o ncurses gera no SIGWINCH)
+void rolar_mural(int linhas, int paginas);
+void redimensionar_tela_partida(void);
 void mostrar_mensagem_vitoria(void);
 void mostrar_mensagem_derrota(void);
 
 int mostrar_menu_principal(void);
 int mostrar_menu_dificuldades(void);
-int mostrar_menu_pos_jogo(int vitoria, int tempo_restante, int erros);
+int mostrar_menu_pos_jogo(int vitoria, int tempo_restante, int erros, const ResumoPlacar *placar,
+                          const ResumoUtilizacao *uso);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include "utilizacao.h"
+#include "../modulos/modulos.h"
+#include <stdio.h>
+#include <string.h>
+
+// Ticks de cada recurso num segundo da partida (0..TICKS_POR_SEGUNDO)
+typedef struct {
+    int segundo_partida;
+    unsigned char ticks_tedax[MAX_TEDAX][3];
+    unsigned char ticks_bancada_ocupada[MAX_BANCADAS];
+    unsigned char pendentes;
+    unsigned char resolvidos;
+} AmostraUtilizacao;
+
+static struct {
+    const GameState *dono;
+    AmostraUtilizacao amostras[MAX_SEGUNDOS_SERIE];
+    int qtd;
+} serie;
+
+void utilizacao_reiniciar(GameState *g) {
+    memset(&g->uso, 0, sizeof(g->uso));
+    if (g == serie.dono) {
+        serie.qtd = 0;
+    }
+}
+
+void utilizacao_gravar_serie(const GameState *g) {
+    serie.dono = g;
+    serie.qtd = 0;
+}
+
+void utilizacao_tick(GameState *g) {
+    UtilizacaoPartida *u = &g->uso;
+    AmostraUtilizacao *a = NULL;
+    long segundo = u->ticks / TICKS_POR_SEGUNDO;
+    if (g == serie.dono && segundo < MAX_SEGUNDOS_SERIE) {
+        a = &serie.amostras[segundo];
+        if (u->ticks % TICKS_POR_SEGUNDO == 0) {
+            memset(a, 0, sizeof(*a));
+            serie.qtd = (int)segundo + 1;
+        }
+    }
+    u->ticks++;
+
+    int livres = 0;
+    int esperando = 0;
+    for (int i = 0; i < g->qtd_tedax; i++) {
+        EstadoTedax e = g->tedax[i].estado;
+        u->ticks_tedax[i][e]++;
+        livres += (e == TEDAX_LIVRE);
+        esperando += (e == TEDAX_ESPERANDO);
+        if (a) {
+            a->ticks_tedax[i][e]++;
+        }
+    }
+    for (int i = 0; i < g->qtd_bancadas; i++) {
+        if (g->bancadas[i].estado == BANCADA_OCUPADA) {
+            u->ticks_bancada_ocupada[i]++;
+            if (a) {
+                a->ticks_bancada_ocupada[i]++;
+            }
+        }
+    }
+
+    u->ticks_algum_esperando += (esperando > 0);
+
+    // Todos os tedax nas bancadas só limita a fase se algum módulo está no mural sem dono
+    if (livres == 0 && esperando == 0 && g->pendentes_livres > 0) {
+        u->ticks_pendente_sem_tedax++;
+    }
+    if (a) {
+        a->segundo_partida = g->tempo_total_partida - g->tempo_restante;
+        a->pendentes = (unsigned char)g->pendentes_livres;
+        a->resolvidos = (unsigned char)contar_modulos_resolvidos(g);
+    }
+}
+
+void utilizacao_modulo_atribuido(GameState *g, int modulo_idx) {
+    g->modulos[modulo_idx].atribuido_no_tick = (int)g->uso.ticks;
+}
+
+void utilizacao_modulo_iniciado(GameState *g, int modulo_idx) {
+    Modulo *mod = &g->modulos[modulo_idx];
+    if (mod->atribuido_no_tick < 0) {
+        return;
+    }
+    int espera = (int)g->uso.ticks - mod->atribuido_no_tick;
+    mod->espera_inicio = espera;
+    mod->atribuido_no_tick = -1;
+
+    UtilizacaoPartida *u = &g->uso;
+    u->esperas++;
+    u->soma_espera += espera;
+    if (espera > u->max_espera) {
+        u->max_espera = espera;
+    }
+}
+
+void resumir_utilizacao(const GameState *g, ResumoUtilizacao *r) {
+    const UtilizacaoPartida *u = &g->uso;
+    double ticks = u->ticks > 0 ? (double)u->ticks : 1.0;
+    memset(r, 0, sizeof(*r));
+    r->qtd_tedax = g->qtd_tedax;
+    r->qtd_bancadas = g->qtd_bancadas;
+
+    for (int i = 0; i < g->qtd_tedax; i++) {
+        for (int e = 0; e < 3; e++) {
+            r->tedax[i][e] = 100.0 * u->ticks_tedax[i][e] / ticks;
+        }
+    }
+    r->tedax_esperando = 100.0 * u->ticks_algum_esperando / ticks;
+    for (int i = 0; i < g->qtd_bancadas; i++) {
+        r->bancada_ocupada[i] = 100.0 * u->ticks_bancada_ocupada[i] / ticks;
+    }
+    r->pendente_sem_tedax = 100.0 * u->ticks_pendente_sem_tedax / ticks;
+
+    r->esperas = (int)u->esperas;
+    if (u->esperas > 0) {
+        r->espera_media = (double)u->soma_espera / u->esperas / TICKS_POR_SEGUNDO;
+    }
+    r->espera_max = (double)u->max_espera / TICKS_POR_SEGUNDO;
+
+    long soma_latencia = 0;
+    for (int i = 0; i < g->qtd_modulos; i++) {
+        int latencia = g->modulos[i].tempo_solucao;
+        if (g->quente.estado[i] != MOD_RESOLVIDO || latencia < 0) {
+            continue;
+        }
+        r->resolvidos++;
+        soma_latencia += latencia;
+        if (latencia > r->latencia_max) {
+            r->latencia_max = latencia;
+        }
+    }
+    if (r->resolvidos > 0) {
+        r->latencia_media = (double)soma_latencia / r->resolvidos;
+    }
+
+    // Tedax parados à espera de bancada contra módulos parados à espera de tedax (com todas
+    // as bancadas em uso por eles)
+    if (r->tedax_esperando < LIMIAR_GARGALO && r->pendente_sem_tedax < LIMIAR_GARGALO) {
+        r->gargalo = "nenhum (ritmo do mural)";
+    } else if (r->tedax_esperando >= r->pendente_sem_tedax) {
+        r->gargalo = "bancadas";
+    } else {
+        r->gargalo = "tedax";
+    }
+}
+
+static int exportar_serie(const GameState *g, const char *caminho) {
+    FILE *f = fopen(caminho, "w");
+    if (!f) {
+        return 0;
+    }
+    static const char *estados[3] = { "livre", "ocupado", "esperando" };
+    fprintf(f, "segundo,segundo_partida");
+    for (int i = 0; i < g->qtd_tedax; i++) {
+        for (int e = 0; e < 3; e++) {
+            fprintf(f, ",tedax%d_%s", g->tedax[i].id, estados[e]);
+        }
+    }
+    for (int i = 0; i < g->qtd_bancadas; i++) {
+        fprintf(f, ",bancada%d_ocupada", g->bancadas[i].id);
+    }
+    fprintf(f, ",pendentes,resolvidos\n");
+
+    int qtd = (g == serie.dono) ? serie.qtd : 0;
+    for (int s = 0; s < qtd; s++) {
+        const AmostraUtilizacao *a = &serie.amostras[s];
+        fprintf(f, "%d,%d", s, a->segundo_partida);
+        for (int i = 0; i < g->qtd_tedax; i++) {
+            for (int e = 0; e < 3; e++) {
+                fprintf(f, ",%.1f", (double)a->ticks_tedax[i][e] / TICKS_POR_SEGUNDO);
+            }
+        }
+        for (int i = 0; i < g->qtd_bancadas; i++) {
+            fprintf(f, ",%.1f", (double)a->ticks_bancada_ocupada[i] / TICKS_POR_SEGUNDO);
+        }
+        fprintf(f, ",%d,%d\n", a->pendentes, a->resolvidos);
+    }
+    return fclose(f) == 0;
+}
+
+static int exportar_modulos(const GameState *g, const char *caminho) {
+    FILE *f = fopen(caminho, "w");
+    if (!f) {
+        return 0;
+    }
+    fprintf(f, "id,tipo,tempo_total,criado_em,espera_inicio,solucao,estado\n");
+    for (int i = 0; i < g->qtd_modulos; i++) {
+        const Modulo *mod = &g->modulos[i];
+        fprintf(f, "%d,%s,%d,%d,", g->quente.id[i], nome_tipo_modulo(mod->tipo), mod->tempo_total,
+                mod->criado_em);
+        if (mod->espera_inicio >= 0) {
+            fprintf(f, "%.1f", (double)mod->espera_inicio / TICKS_POR_SEGUNDO);
+        }
+        fprintf(f, ",");
+        if (g->quente.estado[i] == MOD_RESOLVIDO && mod->tempo_solucao >= 0) {
+            fprintf(f, "%d", mod->tempo_solucao);
+        }
+        fprintf(f, ",%s\n", nome_estado_modulo(g->quente.estado[i]));
+    }
+    return fclose(f) == 0;
+}
+
+int exportar_utilizacao(const GameState *g, const char *prefixo) {
+    char caminho[512];
+    snprintf(caminho, sizeof(caminho), "%s.csv", prefixo);
+    int ok = exportar_serie(g, caminho);
+    snprintf(caminho, sizeof(caminho), "%s_modulos.csv", prefixo);
+    return exportar_modulos(g, caminho) && ok;
+}
@@ -0,0 +1,47 @@
+#ifndef UTILIZACAO_H
+#define UTILIZACAO_H
+
+#include "../game/game.h"
+
+// Uso dos recursos da partida (UtilizacaoPartida em GameState): a cada tick soma o estado
+// de cada tedax e de cada bancada; cada módulo guarda a espera do comando aceito até o
+// início na bancada. Serve para dizer se uma fase é limitada pelas bancadas (tedax parados
+// esperando bancada) ou pelos tedax (módulos no mural e todos os tedax trabalhando).
+// As funções que escrevem exigem mutex_jogo travado (ou as threads da partida paradas).
+
+#define MAX_SEGUNDOS_SERIE 3600             // Maior tempo_total_partida aceito em fases.cfg
+#define PREFIXO_UTILIZACAO_PADRAO "utilizacao"
+#define LIMIAR_GARGALO 10.0                 // % do tempo abaixo do qual não há gargalo
+
+typedef struct {
+    int qtd_tedax;
+    int qtd_bancadas;
+    double tedax[MAX_TEDAX][3];             // % do tempo em cada EstadoTedax
+    double bancada_ocupada[MAX_BANCADAS];   // % do tempo ocupada
+    double tedax_esperando;                 // % do tempo com algum tedax esperando bancada
+    double pendente_sem_tedax;              // % do tempo com módulo sem dono e todos os tedax nas bancadas
+    int esperas;
+    double espera_media;                    // s do comando aceito ao início na bancada
+    double espera_max;
+    int resolvidos;
+    double latencia_media;                  // s do mural até resolvido
+    int latencia_max;
+    const char *gargalo;
+} ResumoUtilizacao;
+
+void utilizacao_reiniciar(GameState *g);
+void utilizacao_tick(GameState *g);
+void utilizacao_modulo_atribuido(GameState *g, int modulo_idx);
+void utilizacao_modulo_iniciado(GameState *g, int modulo_idx);
+
+// Grava também a série por segundo deste GameState (uma partida por vez; a da anterior é descartada)
+void utilizacao_gravar_serie(const GameState *g);
+
+void resumir_utilizacao(const GameState *g, ResumoUtilizacao *r);
+
+// <prefixo>.csv: uma linha por segundo (fração do segundo de cada tedax em cada estado e de
+// cada bancada ocupada); <prefixo>_modulos.csv: espera e latência de cada módulo.
+// TEDAX_UTILIZACAO=<prefixo> exporta ao fim de cada partida clássica. Retorna 1 se gravou
+int exportar_utilizacao(const GameState *g, const char *prefixo);
+
+#endif // UTILIZACAO_H